@@ -0,0 +1,330 @@
+#include "PongState.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PONG_SSE2
+#include <emmintrin.h>
+#endif
+
+PongState::PongState() {
+	userPaddleY = 0.0f;
+	aiPaddleY = 0.0f;
+	aiPaddleGoingUp = true; // Default value
+	ballX = 0.0f;
+	ballY = 0.0f;
+	isBallGoingUp = true; // Default value
+	isBallGoingRight = true; // Default value
+	isGameOver = false;
+	playerWon = false;
+}
+
+void PongState::Step(int action, float elapsed) {
+	float distance = elapsed * PONG_SPEED;
+
+	// Allow user to move the paddle up and down
+	if (action == PONG_UP && (userPaddleY + (PONG_PADDLE_HEIGHT / 2) < PONG_EDGE_Y)) {
+		userPaddleY += distance;
+	}
+	else if (action == PONG_DOWN && (userPaddleY - (PONG_PADDLE_HEIGHT / 2) > -PONG_EDGE_Y)) {
+		userPaddleY -= distance;
+	}
+
+	if (isGameOver) {
+		ballX = 0.0f;
+		ballY = 0.0f;
+		isGameOver = false;
+		isBallGoingRight = playerWon;
+	}
+
+	// Handle AI's paddle movement (goes up and down repeatedly)
+	if (aiPaddleGoingUp) {
+		if (aiPaddleY + (PONG_PADDLE_HEIGHT / 2) < PONG_EDGE_Y) {
+			aiPaddleY += distance;
+		}
+		else {
+			aiPaddleGoingUp = false;
+		}
+	}
+	else {
+		if (aiPaddleY - (PONG_PADDLE_HEIGHT / 2) > -PONG_EDGE_Y) {
+			aiPaddleY -= distance;
+		}
+		else {
+			aiPaddleGoingUp = true;
+		}
+	}
+
+	// Handle ball movement along the y-axis
+	if (isBallGoingUp) {
+		if (ballY + PONG_BALL_HALF_SIZE < PONG_EDGE_Y) {
+			ballY += distance;
+		}
+		else {
+			isBallGoingUp = false;
+		}
+	}
+	else {
+		if (ballY - PONG_BALL_HALF_SIZE > -PONG_EDGE_Y) {
+			ballY -= distance;
+		}
+		else {
+			isBallGoingUp = true;
+		}
+	}
+
+	// Handle ball movement along the x-axis
+	if (isBallGoingRight) {
+		ballX += distance;
+		if (ballX - (PONG_BALL_RADIUS / 2) > PONG_EDGE_X) {
+			isGameOver = true;
+			playerWon = false;
+		}
+		else {
+			// Check for paddle collision
+			if (ballY < userPaddleY + (PONG_PADDLE_HEIGHT / 2) &&
+				ballY > userPaddleY - (PONG_PADDLE_HEIGHT / 2) &&
+				ballX + (PONG_BALL_RADIUS / 2) > PONG_PADDLE_OFFSET_X - PONG_PADDLE_WIDTH &&
+				ballX + (PONG_BALL_RADIUS / 2) < PONG_PADDLE_OFFSET_X - PONG_PADDLE_WIDTH + 0.01f) {	// The 0.01f is necessary to make sure the
+				isBallGoingRight = false;																// ball only rebounds if it hits the paddle.
+			}
+		}
+	}
+	else {
+		if (ballX - (PONG_BALL_RADIUS / 2) > -PONG_EDGE_X) {
+			ballX -= distance;
+
+			// Check for paddle collision
+			if (ballY < aiPaddleY + (PONG_PADDLE_HEIGHT / 2) &&
+				ballY > aiPaddleY - (PONG_PADDLE_HEIGHT / 2) &&
+				ballX - (PONG_BALL_RADIUS / 2) < PONG_PADDLE_WIDTH - PONG_PADDLE_OFFSET_X &&
+				ballX - (PONG_BALL_RADIUS / 2) > PONG_PADDLE_WIDTH - PONG_PADDLE_OFFSET_X - 0.01f) {
+				isBallGoingRight = true;
+			}
+		}
+		else {
+			isGameOver = true;
+			playerWon = true;
+		}
+	}
+}
+
+void PongBatch::Setup(size_t count) {
+	userPaddleY.assign(count, 0.0f);
+	aiPaddleY.assign(count, 0.0f);
+	aiPaddleGoingUp.assign(count, 1.0f);
+	ballX.assign(count, 0.0f);
+	ballY.assign(count, 0.0f);
+	isBallGoingUp.assign(count, 1.0f);
+	isBallGoingRight.assign(count, 1.0f);
+	isGameOver.assign(count, 0.0f);
+	playerWon.assign(count, 0.0f);
+}
+
+void PongBatch::Step(const int *actions, float elapsed, float *observations, float *rewards) {
+	Step(actions, elapsed, observations, rewards, 0, Count());
+}
+
+#ifdef PONG_SSE2
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+// PongState::Step() with every if turned into a select. Moving by 0.0f instead of skipping
+// the move leaves a float unchanged, so the results match the scalar game bit for bit.
+// Four games are stepped per SSE2 instruction; the scalar loop finishes the rest.
+void PongBatch::Step(const int *actions, float elapsed, float *observations, float *rewards, size_t begin, size_t end) {
+	float *__restrict user = userPaddleY.data();
+	float *__restrict ai = aiPaddleY.data();
+	float *__restrict aiUp = aiPaddleGoingUp.data();
+	float *__restrict bx = ballX.data();
+	float *__restrict by = ballY.data();
+	float *__restrict ballUp = isBallGoingUp.data();
+	float *__restrict ballRight = isBallGoingRight.data();
+	float *__restrict over = isGameOver.data();
+	float *__restrict won = playerWon.data();
+	const int *__restrict action = actions;
+	float *__restrict observation = observations;
+	float *__restrict reward = rewards;
+	float distance = elapsed * PONG_SPEED;
+
+#ifdef PONG_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 minusOne = _mm_set1_ps(-1.0f);
+	const __m128 step = _mm_set1_ps(distance);
+	const __m128 halfPaddle = _mm_set1_ps(PONG_PADDLE_HEIGHT / 2);
+	const __m128 halfBall = _mm_set1_ps(PONG_BALL_HALF_SIZE);
+	const __m128 halfRadius = _mm_set1_ps(PONG_BALL_RADIUS / 2);
+	const __m128 top = _mm_set1_ps(PONG_EDGE_Y);
+	const __m128 bottom = _mm_set1_ps(-PONG_EDGE_Y);
+	const __m128 rightEdge = _mm_set1_ps(PONG_EDGE_X);
+	const __m128 leftEdge = _mm_set1_ps(-PONG_EDGE_X);
+	const __m128 userFace = _mm_set1_ps(PONG_PADDLE_OFFSET_X - PONG_PADDLE_WIDTH);
+	const __m128 userFaceBack = _mm_set1_ps(PONG_PADDLE_OFFSET_X - PONG_PADDLE_WIDTH + 0.01f);
+	const __m128 aiFace = _mm_set1_ps(PONG_PADDLE_WIDTH - PONG_PADDLE_OFFSET_X);
+	const __m128 aiFaceBack = _mm_set1_ps(PONG_PADDLE_WIDTH - PONG_PADDLE_OFFSET_X - 0.01f);
+	const __m128i upAction = _mm_set1_epi32(PONG_UP);
+	const __m128i downAction = _mm_set1_epi32(PONG_DOWN);
+
+	for (; begin + 4 <= end; begin += 4) {
+		size_t i = begin;
+		__m128i actionGroup = _mm_loadu_si128((const __m128i *)(action + i));
+		__m128 pressedUp = _mm_castsi128_ps(_mm_cmpeq_epi32(actionGroup, upAction));
+		__m128 pressedDown = _mm_castsi128_ps(_mm_cmpeq_epi32(actionGroup, downAction));
+
+		__m128 userY = _mm_loadu_ps(user + i);
+		__m128 userUp = _mm_and_ps(_mm_and_ps(pressedUp, _mm_cmplt_ps(_mm_add_ps(userY, halfPaddle), top)), step);
+		__m128 userDown = _mm_and_ps(_mm_and_ps(pressedDown, _mm_cmpgt_ps(_mm_sub_ps(userY, halfPaddle), bottom)), step);
+		userY = _mm_sub_ps(_mm_add_ps(userY, userUp), userDown);
+
+		// Reset a finished round
+		__m128 restart = _mm_cmpneq_ps(_mm_loadu_ps(over + i), zero);
+		__m128 won4 = _mm_loadu_ps(won + i);
+		__m128 x = _mm_andnot_ps(restart, _mm_loadu_ps(bx + i));
+		__m128 y = _mm_andnot_ps(restart, _mm_loadu_ps(by + i));
+		__m128 goingRight = _mm_cmpneq_ps(Select(restart, won4, _mm_loadu_ps(ballRight + i)), zero);
+
+		// AI paddle
+		__m128 aiY = _mm_loadu_ps(ai + i);
+		__m128 aiGoingUp = _mm_cmpneq_ps(_mm_loadu_ps(aiUp + i), zero);
+		__m128 aiCanUp = _mm_cmplt_ps(_mm_add_ps(aiY, halfPaddle), top);
+		__m128 aiCanDown = _mm_cmpgt_ps(_mm_sub_ps(aiY, halfPaddle), bottom);
+		aiY = Select(aiGoingUp, _mm_add_ps(aiY, _mm_and_ps(aiCanUp, step)), _mm_sub_ps(aiY, _mm_and_ps(aiCanDown, step)));
+		aiGoingUp = Select(aiGoingUp, aiCanUp, _mm_andnot_ps(aiCanDown, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+
+		// Ball along the y-axis
+		__m128 up = _mm_cmpneq_ps(_mm_loadu_ps(ballUp + i), zero);
+		__m128 ballCanUp = _mm_cmplt_ps(_mm_add_ps(y, halfBall), top);
+		__m128 ballCanDown = _mm_cmpgt_ps(_mm_sub_ps(y, halfBall), bottom);
+		y = Select(up, _mm_add_ps(y, _mm_and_ps(ballCanUp, step)), _mm_sub_ps(y, _mm_and_ps(ballCanDown, step)));
+		up = Select(up, ballCanUp, _mm_andnot_ps(ballCanDown, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+
+		// Ball going right
+		__m128 rightX = _mm_add_ps(x, step);
+		__m128 rightOut = _mm_cmpgt_ps(_mm_sub_ps(rightX, halfRadius), rightEdge);
+		__m128 rightFront = _mm_add_ps(rightX, halfRadius);
+		__m128 userHit = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(y, _mm_add_ps(userY, halfPaddle)), _mm_cmpgt_ps(y, _mm_sub_ps(userY, halfPaddle))),
+			_mm_and_ps(_mm_cmpgt_ps(rightFront, userFace), _mm_cmplt_ps(rightFront, userFaceBack)));
+
+		// Ball going left
+		__m128 leftIn = _mm_cmpgt_ps(_mm_sub_ps(x, halfRadius), leftEdge);
+		__m128 leftX = _mm_sub_ps(x, _mm_and_ps(leftIn, step));
+		__m128 leftFront = _mm_sub_ps(leftX, halfRadius);
+		__m128 aiHit = _mm_and_ps(_mm_and_ps(leftIn, _mm_and_ps(_mm_cmplt_ps(y, _mm_add_ps(aiY, halfPaddle)), _mm_cmpgt_ps(y, _mm_sub_ps(aiY, halfPaddle)))),
+			_mm_and_ps(_mm_cmplt_ps(leftFront, aiFace), _mm_cmpgt_ps(leftFront, aiFaceBack)));
+
+		__m128 finished = Select(goingRight, rightOut, _mm_andnot_ps(leftIn, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+		__m128 playerWins = Select(goingRight, _mm_andnot_ps(rightOut, won4), Select(leftIn, won4, one));
+		__m128 right = Select(goingRight, _mm_or_ps(rightOut, _mm_cmpeq_ps(userHit, zero)), aiHit);
+		x = Select(goingRight, rightX, leftX);
+
+		_mm_storeu_ps(user + i, userY);
+		_mm_storeu_ps(ai + i, aiY);
+		_mm_storeu_ps(aiUp + i, _mm_and_ps(aiGoingUp, one));
+		_mm_storeu_ps(bx + i, x);
+		_mm_storeu_ps(by + i, y);
+		_mm_storeu_ps(ballUp + i, _mm_and_ps(up, one));
+		_mm_storeu_ps(ballRight + i, _mm_and_ps(right, one));
+		_mm_storeu_ps(over + i, _mm_and_ps(finished, one));
+		_mm_storeu_ps(won + i, playerWins);
+		_mm_storeu_ps(reward + i, _mm_and_ps(finished, Select(_mm_cmpneq_ps(playerWins, zero), one, minusOne)));
+
+		// Observations are stored per game, so write the lanes out one game at a time
+		float lanes[PONG_OBSERVATION_SIZE][4];
+		_mm_storeu_ps(lanes[0], userY);
+		_mm_storeu_ps(lanes[1], aiY);
+		_mm_storeu_ps(lanes[2], x);
+		_mm_storeu_ps(lanes[3], y);
+		_mm_storeu_ps(lanes[4], Select(right, one, minusOne));
+		_mm_storeu_ps(lanes[5], Select(up, one, minusOne));
+		for (int lane = 0; lane < 4; lane++) {
+			for (int k = 0; k < PONG_OBSERVATION_SIZE; k++) {
+				observation[(i + lane) * PONG_OBSERVATION_SIZE + k] = lanes[k][lane];
+			}
+		}
+	}
+#endif
+
+	for (size_t i = begin; i < end; i++) {
+		float userY = user[i];
+		float userUp = (action[i] == PONG_UP && userY + (PONG_PADDLE_HEIGHT / 2) < PONG_EDGE_Y) ? distance : 0.0f;
+		float userDown = (action[i] == PONG_DOWN && userY - (PONG_PADDLE_HEIGHT / 2) > -PONG_EDGE_Y) ? distance : 0.0f;
+		userY = userY + userUp - userDown;
+
+		// Reset a finished round
+		float restart = over[i];
+		float x = restart != 0.0f ? 0.0f : bx[i];
+		float y = restart != 0.0f ? 0.0f : by[i];
+		float right = restart != 0.0f ? won[i] : ballRight[i];
+
+		// AI paddle
+		float aiY = ai[i];
+		float goingUp = aiUp[i];
+		bool aiCanUp = aiY + (PONG_PADDLE_HEIGHT / 2) < PONG_EDGE_Y;
+		bool aiCanDown = aiY - (PONG_PADDLE_HEIGHT / 2) > -PONG_EDGE_Y;
+		aiY = goingUp != 0.0f ? aiY + (aiCanUp ? distance : 0.0f) : aiY - (aiCanDown ? distance : 0.0f);
+		goingUp = goingUp != 0.0f ? (aiCanUp ? 1.0f : 0.0f) : (aiCanDown ? 0.0f : 1.0f);
+
+		// Ball along the y-axis
+		float up = ballUp[i];
+		bool ballCanUp = y + PONG_BALL_HALF_SIZE < PONG_EDGE_Y;
+		bool ballCanDown = y - PONG_BALL_HALF_SIZE > -PONG_EDGE_Y;
+		y = up != 0.0f ? y + (ballCanUp ? distance : 0.0f) : y - (ballCanDown ? distance : 0.0f);
+		up = up != 0.0f ? (ballCanUp ? 1.0f : 0.0f) : (ballCanDown ? 0.0f : 1.0f);
+
+		// Ball going right: move, then either leave the court or bounce off the player's paddle
+		float rightX = x + distance;
+		bool rightOut = rightX - (PONG_BALL_RADIUS / 2) > PONG_EDGE_X;
+		bool userHit = y < userY + (PONG_PADDLE_HEIGHT / 2) &&
+			y > userY - (PONG_PADDLE_HEIGHT / 2) &&
+			rightX + (PONG_BALL_RADIUS / 2) > PONG_PADDLE_OFFSET_X - PONG_PADDLE_WIDTH &&
+			rightX + (PONG_BALL_RADIUS / 2) < PONG_PADDLE_OFFSET_X - PONG_PADDLE_WIDTH + 0.01f;
+
+		// Ball going left: move if still in the court, then bounce off the AI's paddle
+		bool leftIn = x - (PONG_BALL_RADIUS / 2) > -PONG_EDGE_X;
+		float leftX = x - (leftIn ? distance : 0.0f);
+		bool aiHit = leftIn &&
+			y < aiY + (PONG_PADDLE_HEIGHT / 2) &&
+			y > aiY - (PONG_PADDLE_HEIGHT / 2) &&
+			leftX - (PONG_BALL_RADIUS / 2) < PONG_PADDLE_WIDTH - PONG_PADDLE_OFFSET_X &&
+			leftX - (PONG_BALL_RADIUS / 2) > PONG_PADDLE_WIDTH - PONG_PADDLE_OFFSET_X - 0.01f;
+
+		bool goingRight = right != 0.0f;
+		float finished = goingRight ? (rightOut ? 1.0f : 0.0f) : (leftIn ? 0.0f : 1.0f);
+		float playerWins = goingRight ? (rightOut ? 0.0f : won[i]) : (leftIn ? won[i] : 1.0f);
+		right = goingRight ? (rightOut || !userHit ? 1.0f : 0.0f) : (aiHit ? 1.0f : 0.0f);
+		x = goingRight ? rightX : leftX;
+
+		user[i] = userY;
+		ai[i] = aiY;
+		aiUp[i] = goingUp;
+		bx[i] = x;
+		by[i] = y;
+		ballUp[i] = up;
+		ballRight[i] = right;
+		over[i] = finished;
+		won[i] = playerWins;
+
+		observation[i * PONG_OBSERVATION_SIZE + 0] = userY;
+		observation[i * PONG_OBSERVATION_SIZE + 1] = aiY;
+		observation[i * PONG_OBSERVATION_SIZE + 2] = x;
+		observation[i * PONG_OBSERVATION_SIZE + 3] = y;
+		observation[i * PONG_OBSERVATION_SIZE + 4] = right != 0.0f ? 1.0f : -1.0f;
+		observation[i * PONG_OBSERVATION_SIZE + 5] = up != 0.0f ? 1.0f : -1.0f;
+		reward[i] = finished != 0.0f ? (playerWins != 0.0f ? 1.0f : -1.0f) : 0.0f;
+	}
+}
+
+PongState PongBatch::Get(size_t i) const {
+	PongState state;
+	state.userPaddleY = userPaddleY[i];
+	state.aiPaddleY = aiPaddleY[i];
+	state.aiPaddleGoingUp = aiPaddleGoingUp[i] != 0.0f;
+	state.ballX = ballX[i];
+	state.ballY = ballY[i];
+	state.isBallGoingUp = isBallGoingUp[i] != 0.0f;
+	state.isBallGoingRight = isBallGoingRight[i] != 0.0f;
+	state.isGameOver = isGameOver[i] != 0.0f;
+	state.playerWon = playerWon[i] != 0.0f;
+	return state;
+}
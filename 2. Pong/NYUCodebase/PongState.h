@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+// Court and speeds (the player's paddle is on the right, the AI's on the left)
+#define PONG_SPEED 1.0f				// Distance per second for the paddles and the ball
+#define PONG_PADDLE_WIDTH 0.1f
+#define PONG_PADDLE_HEIGHT 0.5f
+#define PONG_PADDLE_OFFSET_X 1.5f
+#define PONG_BALL_RADIUS 0.1f
+#define PONG_BALL_HALF_SIZE 0.05f
+#define PONG_EDGE_X 1.777f
+#define PONG_EDGE_Y 1.0f
+
+// userPaddleY, aiPaddleY, ballX, ballY, ball direction x and y (+1 or -1)
+#define PONG_OBSERVATION_SIZE 6
+
+enum PongAction { PONG_STAY, PONG_UP, PONG_DOWN };
+
+// One game of Pong with no window or rendering attached
+struct PongState {
+	PongState();
+
+	// Advances the game by elapsed seconds with the player's paddle doing action.
+	// A finished round is reset at the start of the next step.
+	void Step(int action, float elapsed);
+
+	float userPaddleY;
+	float aiPaddleY;
+	bool aiPaddleGoingUp;
+
+	float ballX;
+	float ballY;
+	bool isBallGoingUp;
+	bool isBallGoingRight;
+
+	bool isGameOver;
+	bool playerWon;
+};
+
+// Thousands of independent games stepped together for agent training. The state is kept
+// as parallel arrays with the flags stored as 0/1 floats, and the step is written without
+// branches so the compiler turns it into SIMD code. Each game follows exactly the same
+// rules (and float math) as PongState::Step().
+class PongBatch {
+public:
+	void Setup(size_t count);
+	size_t Count() const { return ballX.size(); }
+
+	// Steps every game with one action each and writes PONG_OBSERVATION_SIZE floats per game
+	// to observations and the round result to rewards (+1 player won, -1 AI won, 0 still playing)
+	void Step(const int *actions, float elapsed, float *observations, float *rewards);
+
+	// Steps games [begin, end) only, so a batch can be split across jobs
+	void Step(const int *actions, float elapsed, float *observations, float *rewards, size_t begin, size_t end);
+
+	PongState Get(size_t i) const;
+
+private:
+	std::vector<float> userPaddleY;
+	std::vector<float> aiPaddleY;
+	std::vector<float> aiPaddleGoingUp;
+	std::vector<float> ballX;
+	std::vector<float> ballY;
+	std::vector<float> isBallGoingUp;
+	std::vector<float> isBallGoingRight;
+	std::vector<float> isGameOver;
+	std::vector<float> playerWon;
+};
@@ -1,9 +0,0 @@
-/// @ref core
-/// @file glm/mat4x2.hpp
-
-#pragma once
-#include "./ext/matrix_double4x2.hpp"
-#include "./ext/matrix_double4x2_precision.hpp"
-#include "./ext/matrix_float4x2.hpp"
-#include "./ext/matrix_float4x2_precision.hpp"
-
@@ -1,48 +0,0 @@
-/// @ref gtx_extend
-
-namespace glm
-{
-	template<typename genType>
-	GLM_FUNC_QUALIFIER genType extend
-	(
-		genType const& Origin,
-		genType const& Source,
-		genType const& Distance
-	)
-	{
-		return Origin + (Source - Origin) * Distance;
-	}
-
-	template<typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<2, T, Q> extend
-	(
-		vec<2, T, Q> const& Origin,
-		vec<2, T, Q> const& Source,
-		T const& Distance
-	)
-	{
-		return Origin + (Source - Origin) * Distance;
-	}
-
-	template<typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<3, T, Q> extend
-	(
-		vec<3, T, Q> const& Origin,
-		vec<3, T, Q> const& Source,
-		T const& Distance
-	)
-	{
-		return Origin + (Source - Origin) * Distance;
-	}
-
-	template<typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<4, T, Q> extend
-	(
-		vec<4, T, Q> const& Origin,
-		vec<4, T, Q> const& Source,
-		T const& Distance
-	)
-	{
-		return Origin + (Source - Origin) * Distance;
-	}
-}//namespace glm
@@ -1,36 +0,0 @@
-/// @ref gtx_scalar_relational
-/// @file glm/gtx/scalar_relational.hpp
-///
-/// @see core (dependence)
-///
-/// @defgroup gtx_scalar_relational GLM_GTX_scalar_relational
-/// @ingroup gtx
-///
-/// Include <glm/gtx/scalar_relational.hpp> to use the features of this extension.
-///
-/// Extend a position from a source to a position at a defined length.
-
-#pragma once
-
-// Dependency:
-#include "../glm.hpp"
-
-#ifndef GLM_ENABLE_EXPERIMENTAL
-#	error "GLM: GLM_GTX_extend is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
-#endif
-
-#if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
-#	pragma message("GLM: GLM_GTX_extend extension included")
-#endif
-
-namespace glm
-{
-	/// @addtogroup gtx_scalar_relational
-	/// @{
-
-
-
-	/// @}
-}//namespace glm
-
-#include "scalar_relational.inl"
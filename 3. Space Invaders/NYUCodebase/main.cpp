@@ -7,13 +7,19 @@
 #include <SDL_image.h>
 
 #include "ShaderProgram.h"
+#include "Texture.h"
+#include "SheetSprite.h"
+#include "Text.h"
+#include "FrameArena.h"
+#include "InputQueue.h"
+#include "GLStats.h"
+#include "FramePacer.h"
+#include "FrameProfiler.h"
+#include "Benchmark.h"
+#include "Trace.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
-// Load images in any format with STB_image
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-
 #ifdef _WINDOWS
 #define RESOURCE_FOLDER ""
 #else
@@ -21,85 +27,31 @@
 #endif
 
 #include <vector>
+#include <cmath>
+#include <algorithm>
 
 SDL_Window* displayWindow;
+FramePacer framePacer;
+FrameProfiler profiler;
+Benchmark benchmark;			// --benchmark menu|formation: play a scripted scenario and report frame times
+bool benchmarkLevel = false;	// The formation benchmark starts a level whenever the menu comes up
 ShaderProgram program;			// For untextured polygons
 ShaderProgram texturedProgram;  // For textured polygons
 
 // Constants
-size_t MAX_NUM_LASERS  = 15;
+size_t MAX_NUM_LASERS  = 15;	// Lasers in flight at once, reserved up front
 size_t MAX_NUM_METEORS = 30;
 size_t NUM_ROWS = 3;
 size_t NUM_METEORS_PER_ROW = MAX_NUM_METEORS / NUM_ROWS;
 float SPACE_BETWEEN_METEORS_X = 2 * 1.5f / NUM_METEORS_PER_ROW;
 float SPACE_BETWEEN_METEORS_Y = 0.3f;
+int BOT_SWEEP_FRAMES = 90;		// Frames the benchmark player flies one way before turning
 
 bool done = false;				// Game loop
-float lastFrameTicks = 0.0f;	// Set time to an initial value of 0
-int numMeteorsLeft = MAX_NUM_METEORS;
 
 GLuint asciiSpriteSheetTexture;
 GLuint spaceSpriteSheetTexture;
 
-class SheetSprite {
-public:
-	SheetSprite();
-	SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size);
-	void Draw(ShaderProgram &program);
-
-	float u;
-	float v;
-	float width;
-	float height;
-	float size;
-	unsigned int textureID;
-};
-
-SheetSprite::SheetSprite() {}
-
-SheetSprite::SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size) {
-	this->textureID = textureID;
-	this->u = u;
-	this->v = v;
-	this->width = width;
-	this->height = height;
-	this->size = size;
-}
-
-void SheetSprite::Draw(ShaderProgram &program) {
-	program.SetColor(1.0f, 0.0f, 0.0f, 1.0f);
-	float aspectRatio = width / height;
-	float vertices[] = { 
-		-0.5f * size * aspectRatio, -0.5f * size,
-		-0.5f * size * aspectRatio,  0.5f * size, 
-		 0.5f * size * aspectRatio, -0.5f * size,
-		 0.5f * size * aspectRatio, -0.5f * size,
-		-0.5f * size * aspectRatio,  0.5f * size,
-		 0.5f * size * aspectRatio,  0.5f * size
-	};
-	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertices);
-	glEnableVertexAttribArray(program.positionAttribute);
-
-	// UV coords are upside down relative to vertices
-	// (everything is rotated 180 degrees around the origin)
-	float texCoords[] = {
-		u + width, v + height,
-		u + width, v,
-		u, v + height,
-		u, v + height,
-		u + width, v,
-		u, v
-	};
-	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoords);
-	glEnableVertexAttribArray(program.texCoordAttribute);
-
-	glBindTexture(GL_TEXTURE_2D, textureID);
-
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glDisableVertexAttribArray(program.positionAttribute);
-	glDisableVertexAttribArray(program.texCoordAttribute);
-}
-
 class Entity {
 public:
 	void Update(float elapsed);
@@ -129,104 +81,163 @@ void Entity::Draw(ShaderProgram &program) {
 	sprite.Draw(program);
 }
 
-void DrawText(ShaderProgram &program, int fontTexture, std::string text, float size, float spacing) {
-	float character_size = 1.0 / 16.0f;
-	std::vector<float> vertexData;
-	std::vector<float> texCoordData;
-	for (size_t i = 0; i < text.size(); i++) {
-		int spriteIndex = (int)text[i];
-		float texture_x = (float)(spriteIndex % 16) / 16.0f;
-		float texture_y = (float)(spriteIndex / 16) / 16.0f;
-		vertexData.insert(vertexData.end(), {
-			((size + spacing) * i) + (-0.5f * size),  0.5f * size,
-			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
-			((size + spacing) * i) +  (0.5f * size),  0.5f * size,
-			((size + spacing) * i) +  (0.5f * size), -0.5f * size,
-			((size + spacing) * i) +  (0.5f * size),  0.5f * size,
-			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
-		});
-		texCoordData.insert(texCoordData.end(), {
-			texture_x, texture_y,
-			texture_x, texture_y + character_size,
-			texture_x + character_size, texture_y,
-			texture_x + character_size, texture_y + character_size,
-			texture_x + character_size, texture_y,
-			texture_x, texture_y + character_size,
-		});
+// The meteors move as one grid, so instead of an Entity per meteor the formation keeps one
+// shared offset and velocity plus an alive bit per meteor. The leftmost and rightmost columns
+// that still have meteors only change when a meteor dies, which makes the wall check O(1),
+// and hit tests look up the grid cells under a box instead of scanning every meteor.
+struct Formation {
+	void Setup(int rows, int columns, float spacingX, float spacingY, float originX, float originY, const SheetSprite &sprite);
+	bool IsAlive(int index) const;
+	void Kill(int index);
+	bool HitsWall() const;
+	int FindHit(float x, float y, float halfWidth, float halfHeight) const;
+	void Update(float elapsed);
+	void Draw(ShaderProgram &program);
+
+	int rows;
+	int columns;
+	float spacingX;
+	float spacingY;
+	float offsetX;		// Center of the meteor in row 0, column 0
+	float offsetY;
+	float velocityX;	// Shared by every meteor
+	SheetSprite sprite;
+
+	std::vector<unsigned int> alive;	// One bit per meteor, indexed by row * columns + column
+	std::vector<int> aliveInColumn;
+	int minColumn;		// Leftmost column with a live meteor
+	int maxColumn;		// Rightmost column with a live meteor
+	int numAlive;
+};
+
+void Formation::Setup(int rows, int columns, float spacingX, float spacingY, float originX, float originY, const SheetSprite &sprite) {
+	this->rows = rows;
+	this->columns = columns;
+	this->spacingX = spacingX;
+	this->spacingY = spacingY;
+	this->offsetX = originX;
+	this->offsetY = originY;
+	this->velocityX = 0.25f; // Have the meteors go right by default
+	this->sprite = sprite;
+
+	numAlive = rows * columns;
+	alive.assign((numAlive + 31) / 32, 0xFFFFFFFFu);
+	if (numAlive % 32 != 0) {
+		alive.back() = (1u << (numAlive % 32)) - 1;
+	}
+	aliveInColumn.assign(columns, rows);
+	minColumn = 0;
+	maxColumn = columns - 1;
+}
+
+bool Formation::IsAlive(int index) const {
+	return (alive[index >> 5] >> (index & 31)) & 1u;
+}
+
+void Formation::Kill(int index) {
+	alive[index >> 5] &= ~(1u << (index & 31));
+	numAlive--;
+	int column = index % columns;
+	aliveInColumn[column]--;
+
+	// Pull the bounds in past columns that are now empty
+	while (minColumn <= maxColumn && aliveInColumn[minColumn] == 0) {
+		minColumn++;
+	}
+	while (maxColumn >= minColumn && aliveInColumn[maxColumn] == 0) {
+		maxColumn--;
+	}
+}
+
+bool Formation::HitsWall() const {
+	if (numAlive == 0) {
+		return false;
 	}
-	glBindTexture(GL_TEXTURE_2D, fontTexture);
-
-	// draw this data (use the .data() method of std::vector to get pointer to data)
-	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertexData.data());
-	glEnableVertexAttribArray(program.positionAttribute);
-
-	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoordData.data());
-	glEnableVertexAttribArray(program.texCoordAttribute);
-
-	// draw this yourself, use text.size() * 6 or vertexData.size()/2 to get number of vertices
-	glDrawArrays(GL_TRIANGLES, 0, 6 * (int)text.size());
-	glDisableVertexAttribArray(program.positionAttribute);
-	glDisableVertexAttribArray(program.texCoordAttribute);
-;}
-
-GLuint LoadTexture(const char *filePath) {
-	int w, h, comp;
-	unsigned char* image = stbi_load(filePath, &w, &h, &comp, STBI_rgb_alpha);
-	if (image == NULL) {
-		std::cout << "Unable to load image. Make sure the path is correct\n";
-		assert(false);
+	float left = offsetX + minColumn * spacingX;
+	float right = offsetX + maxColumn * spacingX;
+	return right + sprite.width > 1.777f || left - sprite.width < -1.777f;
+}
+
+// Returns the index of the first live meteor overlapping the box, or -1
+int Formation::FindHit(float x, float y, float halfWidth, float halfHeight) const {
+	if (numAlive == 0) {
+		return -1;
+	}
+	// Only the cells whose meteor center is within reach of the box can overlap it
+	float reachX = halfWidth + sprite.width;
+	float reachY = halfHeight + sprite.height;
+	float firstColumn = fmaxf(ceilf((x - reachX - offsetX) / spacingX), (float)minColumn);
+	float lastColumn = fminf(floorf((x + reachX - offsetX) / spacingX), (float)maxColumn);
+	float firstRow = fmaxf(ceilf((y - reachY - offsetY) / spacingY), 0.0f);
+	float lastRow = fminf(floorf((y + reachY - offsetY) / spacingY), (float)(rows - 1));
+	for (int row = (int)firstRow; row <= (int)lastRow; row++) {
+		for (int column = (int)firstColumn; column <= (int)lastColumn; column++) {
+			int index = row * columns + column;
+			float meteorX = offsetX + column * spacingX;
+			float meteorY = offsetY + row * spacingY;
+			if (IsAlive(index) && fabsf(x - meteorX) < reachX && fabsf(y - meteorY) < reachY) {
+				return index;
+			}
+		}
+	}
+	return -1;
+}
+
+void Formation::Update(float elapsed) {
+	offsetX += elapsed * velocityX;
+}
+
+void Formation::Draw(ShaderProgram &program) {
+	for (int row = 0; row < rows; row++) {
+		for (int column = minColumn; column <= maxColumn; column++) {
+			if (!IsAlive(row * columns + column)) {
+				continue;
+			}
+			glm::mat4 modelMatrix = glm::mat4(1.0f);
+			modelMatrix = glm::translate(modelMatrix, glm::vec3(offsetX + column * spacingX, offsetY + row * spacingY, 0.0f));
+			program.SetModelMatrix(modelMatrix);
+			sprite.Draw(program);
+		}
 	}
-	GLuint retTexture;
-	glGenTextures(1, &retTexture);
-	glBindTexture(GL_TEXTURE_2D, retTexture);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	stbi_image_free(image);
-	return retTexture;
 }
 
 enum GameMode { MAIN_MENU, GAME_LEVEL };
 
 struct GameState {
 	Entity player;
-	std::vector<Entity> lasers;
-	std::vector<Entity> meteors;
-	size_t currentLaserIndex = 0;
+	std::vector<Entity> lasers;	// Only lasers in flight; spent ones are swapped out
+	SheetSprite laserSprite;
+	Formation meteors;
+
+	// Lasers in flight, summed over every frame for the stats printed at exit
+	size_t laserFrames = 0;
+	size_t laserSum = 0;
+	size_t laserPeak = 0;
 };
 
 GameState state;
 GameMode mode;
 
 void shootLaser() {
-	state.lasers[state.currentLaserIndex].position = glm::vec3(state.player.position.x, state.player.position.y + 2 * state.player.sprite.height, 0.0f);
-	state.currentLaserIndex++;
-	state.currentLaserIndex = state.currentLaserIndex % MAX_NUM_LASERS;
-}
-
-bool Collides(Entity &entity1, Entity &entity2) {
-	float distanceX = abs(entity1.position.x - entity2.position.x) - (entity1.sprite.width + entity2.sprite.width);
-	float distanceY = abs(entity1.position.y - entity2.position.y) - (entity1.sprite.height + entity2.sprite.height);
-	return distanceX < 0 && distanceY < 0;
-}
-
-bool meteorsCollideWithSide() {
-	for (size_t i = 0; i < state.meteors.size(); i++) {
-		Entity meteor = state.meteors[i];
-		if ((meteor.position.x + meteor.sprite.width > 1.777f && meteor.position.x + meteor.sprite.width < 100) || meteor.position.x - meteor.sprite.width < -1.777f) {
-			return true;
-		}
+	if (state.lasers.size() >= MAX_NUM_LASERS) {
+		return;
 	}
-	return false;
+	Entity laser;
+	laser.sprite = state.laserSprite;
+	laser.position = glm::vec3(state.player.position.x, state.player.position.y + 2 * state.player.sprite.height, 0.0f);
+	laser.velocity = glm::vec3(0.0f, 1.0f, 0.0f);
+	laser.size = glm::vec3(1.0f, 1.0f, 1.0f);
+	state.lasers.push_back(laser);
 }
 
 void SetupMainMenu() {}
 
 void SetupGameLevel() {
-	// Load sprites from sprite sheets
-	SheetSprite playerSprite = SheetSprite(spaceSpriteSheetTexture, 112.0f / 1024.0f, 866.0f / 1024.0f, 112.0f / 1024.0f, 75.0f / 1024.0f, 0.2f);
-	SheetSprite meteorSprite = SheetSprite(spaceSpriteSheetTexture, 327.0f / 1024.0f, 452.0f / 1024.0f, 98.0f / 1024.0f, 96.0f / 1024.0f, 0.25f);
-	SheetSprite laserSprite = SheetSprite(spaceSpriteSheetTexture, 845.0f / 1024.0f, 0.0f / 13.0f, 13.0f / 1024.0f, 57.0f / 1024.0f, 0.2f);
+	TRACE_SCOPE("SetupGameLevel");
+	// Load sprites from sprite sheets, flipped left to right as this game has always drawn them
+	SheetSprite playerSprite = SheetSprite(spaceSpriteSheetTexture, 112.0f / 1024.0f, 866.0f / 1024.0f, 112.0f / 1024.0f, 75.0f / 1024.0f, 0.2f, true);
+	SheetSprite meteorSprite = SheetSprite(spaceSpriteSheetTexture, 327.0f / 1024.0f, 452.0f / 1024.0f, 98.0f / 1024.0f, 96.0f / 1024.0f, 0.25f, true);
+	state.laserSprite = SheetSprite(spaceSpriteSheetTexture, 845.0f / 1024.0f, 0.0f / 13.0f, 13.0f / 1024.0f, 57.0f / 1024.0f, 0.2f, true);
 
 	// Initialize player spaceship
 	state.player.sprite = playerSprite;
@@ -235,30 +246,21 @@ void SetupGameLevel() {
 	state.player.size = glm::vec3(1.0f, 1.0f, 1.0f);
 	
 	// Initialize meteors
-	for (int row = 0; row < NUM_ROWS; row++) {
-		for (int col = 0; col < NUM_METEORS_PER_ROW; col++) {
-			Entity meteor;
-			meteor.sprite = meteorSprite;
-			meteor.velocity = glm::vec3(0.25f, 0.0f, 0.0f); // Have the meteors go right by default
-			meteor.size = glm::vec3(1.0f, 1.0f, 1.0f);
-			meteor.position = glm::vec3((col + 1) * SPACE_BETWEEN_METEORS_X - 1.777f, row * SPACE_BETWEEN_METEORS_Y + 0.2f, 0.0f);
-			state.meteors.push_back(meteor);
-		}
-	}
+	state.meteors.Setup(NUM_ROWS, NUM_METEORS_PER_ROW, SPACE_BETWEEN_METEORS_X, SPACE_BETWEEN_METEORS_Y, SPACE_BETWEEN_METEORS_X - 1.777f, 0.2f, meteorSprite);
 
-	// Initialize lasers
-	for (int i = 0; i < MAX_NUM_LASERS; i++) {
-		Entity laser;
-		laser.sprite = laserSprite;
-		laser.velocity = glm::vec3(0.0f, 1.0f, 0.0f);
-		laser.size = glm::vec3(1.0f, 1.0f, 1.0f);
-		state.lasers.push_back(laser);
-	}
+	// Lasers are added when fired, so start with none in flight
+	state.lasers.clear();
+	state.lasers.reserve(MAX_NUM_LASERS);
 }
 
 void Setup() {
+	TRACE_SCOPE("Setup");
 	SDL_Init(SDL_INIT_VIDEO);
-	displayWindow = SDL_CreateWindow("Space Invaders by Richard Shu", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 640, 360, SDL_WINDOW_OPENGL);
+	Uint32 windowFlags = SDL_WINDOW_OPENGL;
+	if (benchmark.active) {
+		windowFlags |= SDL_WINDOW_HIDDEN;
+	}
+	displayWindow = SDL_CreateWindow("Space Invaders by Richard Shu", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 640, 360, windowFlags);
 	SDL_GLContext context = SDL_GL_CreateContext(displayWindow);
 	SDL_GL_MakeCurrent(displayWindow, context);
 
@@ -267,6 +269,16 @@ void Setup() {
 #endif
 
 	glViewport(0, 0, 640, 360);
+	framePacer.Setup(60);
+
+	// Count GL calls per render pass when GL_STATS or GL_STATS_CSV is set
+	glStats.Setup();
+
+	// A benchmark runs as fast as it can with the GL calls counted
+	if (benchmark.active) {
+		framePacer.SetTarget(FRAME_PACER_UNCAPPED);
+		glStats.enabled = true;
+	}
 
 	// Load shader programs
 	//program.Load(RESOURCE_FOLDER"vertex.glsl", RESOURCE_FOLDER"fragment.glsl");
@@ -299,27 +311,37 @@ void Setup() {
 	SetupMainMenu();
 }
 
+// Every frame is a tick here, so it takes all the input since the last one
 void ProcessEvents() {
-	SDL_Event event;
-	while (SDL_PollEvent(&event)) {
-		if (event.type == SDL_QUIT || event.type == SDL_WINDOWEVENT_CLOSE) {
+	TRACE_SCOPE("Events");
+	inputQueue.Poll();
+	const std::vector<InputEvent> &events = inputQueue.Polled();
+	for (size_t i = 0; i < events.size(); i++) {
+		if (events[i].event.type == SDL_QUIT || events[i].event.type == SDL_WINDOWEVENT_CLOSE) {
 			done = true;
 		}
 	}
+	inputQueue.BeginTick();
 
 	// Allow the player to move the spaceship left and right
-	const Uint8 *keys = SDL_GetKeyboardState(NULL);
 	if (mode == MAIN_MENU) {
-		if (event.type == SDL_MOUSEBUTTONDOWN) {
+		if (inputQueue.Clicked(NULL, NULL) || benchmarkLevel) {
 			mode = GAME_LEVEL;
 			SetupGameLevel();
 		}
 	}
 	else if (mode == GAME_LEVEL) {
-		if (keys[SDL_SCANCODE_LEFT] && state.player.position.x - state.player.sprite.width > -1.777f) {
+		// The benchmark player sweeps from side to side without firing, so the formation stays full
+		bool left = inputQueue.Down(SDL_SCANCODE_LEFT);
+		bool right = inputQueue.Down(SDL_SCANCODE_RIGHT);
+		if (benchmark.active) {
+			left = (benchmark.frame / BOT_SWEEP_FRAMES) % 2 == 0;
+			right = !left;
+		}
+		if (left && state.player.position.x - state.player.sprite.width > -1.777f) {
 			state.player.velocity.x = -1.0f;
 		}
-		else if (keys[SDL_SCANCODE_RIGHT] && state.player.position.x + state.player.sprite.width < 1.777f) {
+		else if (right && state.player.position.x + state.player.sprite.width < 1.777f) {
 			state.player.velocity.x = 1.0f;
 		}
 		else {
@@ -327,53 +349,59 @@ void ProcessEvents() {
 		}
 
 		// Make shooting lasers an input event (rather than a polling event) since it doesn't require continuous checking
-		if (event.key.keysym.scancode == SDL_SCANCODE_SPACE) {
+		if (inputQueue.Pressed(SDL_SCANCODE_SPACE)) {
 			shootLaser();
 		}
 	}
 }
 
-void Update() {
-	// Calculate elapsed time
-	float ticks = (float)SDL_GetTicks() / 1000.0f;
-	float elapsed = ticks - lastFrameTicks;
-	lastFrameTicks = ticks; // Reset
-
+void Update(float elapsed) {
+	TRACE_SCOPE("Update");
 	state.player.Update(elapsed);
 
-	for (size_t i = 0; i < state.lasers.size(); i++) {
-		state.lasers[i].Update(elapsed);
-		
-		// Check for collisions between lasers and meteors
-		for (size_t j = 0; j < state.meteors.size(); j++) {
-			if (Collides(state.lasers[i], state.meteors[j])) {
-				state.lasers[i].position.x = 100.0f;
-				state.meteors[j].position.x = 150.0f;
-				numMeteorsLeft--;
+	// Walk backwards so swapping the last laser into a spent one's slot skips nothing
+	{
+		TRACE_SCOPE("Lasers vs meteors");
+		for (size_t i = state.lasers.size(); i-- > 0;) {
+			Entity &laser = state.lasers[i];
+			laser.Update(elapsed);
+			
+			// Check for collisions between lasers and meteors (a laser stops at the first meteor it hits)
+			int hit = state.meteors.FindHit(laser.position.x, laser.position.y, laser.sprite.width, laser.sprite.height);
+			if (hit >= 0) {
+				state.meteors.Kill(hit);
+			}
+			if (hit >= 0 || laser.position.y - laser.sprite.height > 1.0f) {
+				laser = state.lasers.back();
+				state.lasers.pop_back();
 			}
 		}
 	}
-
-	for (size_t i = 0; i < state.meteors.size(); i++) {
-		state.meteors[i].Update(elapsed);
-
-		// Check for collisions between meteors and player
-		if (Collides(state.meteors[i], state.player) || numMeteorsLeft == 0) {
-			mode = MAIN_MENU;
-			SetupMainMenu();
-		}
+	TRACE_COUNTER("Laser count", state.lasers.size());
+	TRACE_COUNTER("Meteor count", state.meteors.numAlive);
+	state.laserFrames++;
+	state.laserSum += state.lasers.size();
+	state.laserPeak = std::max(state.laserPeak, state.lasers.size());
+
+	state.meteors.Update(elapsed);
+
+	// Check for collisions between meteors and player
+	if (state.meteors.FindHit(state.player.position.x, state.player.position.y, state.player.sprite.width, state.player.sprite.height) >= 0 ||
+		state.meteors.numAlive == 0) {
+		mode = MAIN_MENU;
+		SetupMainMenu();
 	}
 
-	if (meteorsCollideWithSide()) {
-		for (size_t i = 0; i < state.meteors.size(); i++) {
-			state.meteors[i].position.y -= SPACE_BETWEEN_METEORS_Y / 3;
-			state.meteors[i].velocity.x = -state.meteors[i].velocity.x;
-			state.meteors[i].Update(elapsed);
-		}
+	if (state.meteors.HitsWall()) {
+		state.meteors.offsetY -= state.meteors.spacingY / 3;
+		state.meteors.velocityX = -state.meteors.velocityX;
+		state.meteors.Update(elapsed);
 	}
 }
 
 void RenderMainMenu() {
+	TRACE_SCOPE("Menu");
+	glStats.BeginPass("Menu");
 	glm::mat4 modelMatrix = glm::mat4(1.0f);
 	modelMatrix = glm::translate(modelMatrix, glm::vec3(-0.8f, 0.25f, 0.0f));
 	texturedProgram.SetModelMatrix(modelMatrix);
@@ -386,18 +414,29 @@ void RenderMainMenu() {
 }
 
 void RenderGameLevel() {
-	state.player.Draw(texturedProgram);
+	{
+		TRACE_SCOPE("Player");
+		glStats.BeginPass("Player");
+		state.player.Draw(texturedProgram);
+	}
 	
 	// Loop through entities and call their draw methods
-	for (size_t i = 0; i < state.meteors.size(); i++) {
-		state.meteors[i].Draw(texturedProgram);
+	{
+		TRACE_SCOPE("Meteors");
+		glStats.BeginPass("Meteors");
+		state.meteors.Draw(texturedProgram);
 	}
-	for (size_t i = 0; i < state.lasers.size(); i++) {
-		state.lasers[i].Draw(texturedProgram);
+	{
+		TRACE_SCOPE("Lasers");
+		glStats.BeginPass("Lasers");
+		for (size_t i = 0; i < state.lasers.size(); i++) {
+			state.lasers[i].Draw(texturedProgram);
+		}
 	}
 }
 
 void Render() {
+	TRACE_SCOPE("Render");
 	glClear(GL_COLOR_BUFFER_BIT);
 	switch (mode) {
 	case MAIN_MENU:
@@ -407,27 +446,66 @@ void Render() {
 		RenderGameLevel();
 		break;
 	}
-	SDL_GL_SwapWindow(displayWindow);
 }
 
 void Cleanup() {
-	for (size_t i = 0; i < state.meteors.size(); i++) {
-		state.meteors.pop_back();
-	}
-	for (size_t i = 0; i < state.lasers.size(); i++) {
-		state.lasers.pop_back();
-	}
+	state.lasers.clear();
 }
 
 int main(int argc, char *argv[])
 {
+	if (benchmark.ParseArguments(argc, argv)) {
+		benchmarkLevel = benchmark.scenario == "formation";
+		if (benchmark.scenario != "menu" && !benchmarkLevel) {
+			std::cout << "Unknown benchmark scenario " << benchmark.scenario << " (use menu or formation)\n";
+			return 1;
+		}
+	}
+
+	TraceSetup("space_invaders_trace.json");
 	Setup();
 	while (!done) {
+		TRACE_SCOPE("Frame");
+		float elapsed = framePacer.BeginFrame();
+		if (benchmark.active) {
+			elapsed = 1.0f / 60.0f;	// The same steps however long the frame took
+		}
+		profiler.BeginFrame();
+		frameArena.Reset();	// Scratch memory of the last frame is free again
 		ProcessEvents();
-		Update();
+		profiler.EndPhase(PHASE_EVENTS);
+		Update(elapsed);
+		profiler.EndPhase(PHASE_UPDATE);
 		Render();
+		profiler.EndPhase(PHASE_RENDER);
+		{
+			TRACE_SCOPE("Swap");
+			SDL_GL_SwapWindow(displayWindow);
+		}
+		profiler.EndPhase(PHASE_SWAP);
+		glStats.EndFrame();
+		profiler.EndFrame();
+		if (benchmark.active) {
+			benchmark.RecordFrame(profiler, glStats);
+			if (benchmark.Done()) {
+				done = true;
+			}
+		}
+		{
+			TRACE_SCOPE("Pace");
+			framePacer.EndFrame();
+		}
     }
+	framePacer.PrintStats();
+	profiler.PrintStats();
+	frameArena.PrintStats();
+	inputQueue.PrintStats();
+	if (state.laserFrames > 0) {
+		std::cout << "Lasers in flight: average " << (float)state.laserSum / state.laserFrames << ", peak " << state.laserPeak << "\n";
+	}
+	int result = benchmark.active ? benchmark.Finish("Space Invaders") : 0;
+	TraceFlush();
 	Cleanup();
     SDL_Quit();
-    return 0;
+    return result;
 }
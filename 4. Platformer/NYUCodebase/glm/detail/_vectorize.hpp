@@ -1,123 +0,0 @@
-#pragma once
-
-namespace glm{
-namespace detail
-{
-	template<template<length_t L, typename T, qualifier Q> class vec, length_t L, typename R, typename T, qualifier Q>
-	struct functor1{};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename R, typename T, qualifier Q>
-	struct functor1<vec, 1, R, T, Q>
-	{
-		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static vec<1, R, Q> call(R (*Func) (T x), vec<1, T, Q> const& v)
-		{
-			return vec<1, R, Q>(Func(v.x));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename R, typename T, qualifier Q>
-	struct functor1<vec, 2, R, T, Q>
-	{
-		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static vec<2, R, Q> call(R (*Func) (T x), vec<2, T, Q> const& v)
-		{
-			return vec<2, R, Q>(Func(v.x), Func(v.y));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename R, typename T, qualifier Q>
-	struct functor1<vec, 3, R, T, Q>
-	{
-		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static vec<3, R, Q> call(R (*Func) (T x), vec<3, T, Q> const& v)
-		{
-			return vec<3, R, Q>(Func(v.x), Func(v.y), Func(v.z));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename R, typename T, qualifier Q>
-	struct functor1<vec, 4, R, T, Q>
-	{
-		GLM_FUNC_QUALIFIER GLM_CONSTEXPR static vec<4, R, Q> call(R (*Func) (T x), vec<4, T, Q> const& v)
-		{
-			return vec<4, R, Q>(Func(v.x), Func(v.y), Func(v.z), Func(v.w));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, length_t L, typename T, qualifier Q>
-	struct functor2{};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2<vec, 1, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<1, T, Q> call(T (*Func) (T x, T y), vec<1, T, Q> const& a, vec<1, T, Q> const& b)
-		{
-			return vec<1, T, Q>(Func(a.x, b.x));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2<vec, 2, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<2, T, Q> call(T (*Func) (T x, T y), vec<2, T, Q> const& a, vec<2, T, Q> const& b)
-		{
-			return vec<2, T, Q>(Func(a.x, b.x), Func(a.y, b.y));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2<vec, 3, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<3, T, Q> call(T (*Func) (T x, T y), vec<3, T, Q> const& a, vec<3, T, Q> const& b)
-		{
-			return vec<3, T, Q>(Func(a.x, b.x), Func(a.y, b.y), Func(a.z, b.z));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2<vec, 4, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<4, T, Q> call(T (*Func) (T x, T y), vec<4, T, Q> const& a, vec<4, T, Q> const& b)
-		{
-			return vec<4, T, Q>(Func(a.x, b.x), Func(a.y, b.y), Func(a.z, b.z), Func(a.w, b.w));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, length_t L, typename T, qualifier Q>
-	struct functor2_vec_sca{};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2_vec_sca<vec, 1, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<1, T, Q> call(T (*Func) (T x, T y), vec<1, T, Q> const& a, T b)
-		{
-			return vec<1, T, Q>(Func(a.x, b));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2_vec_sca<vec, 2, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<2, T, Q> call(T (*Func) (T x, T y), vec<2, T, Q> const& a, T b)
-		{
-			return vec<2, T, Q>(Func(a.x, b), Func(a.y, b));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2_vec_sca<vec, 3, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<3, T, Q> call(T (*Func) (T x, T y), vec<3, T, Q> const& a, T b)
-		{
-			return vec<3, T, Q>(Func(a.x, b), Func(a.y, b), Func(a.z, b));
-		}
-	};
-
-	template<template<length_t L, typename T, qualifier Q> class vec, typename T, qualifier Q>
-	struct functor2_vec_sca<vec, 4, T, Q>
-	{
-		GLM_FUNC_QUALIFIER static vec<4, T, Q> call(T (*Func) (T x, T y), vec<4, T, Q> const& a, T b)
-		{
-			return vec<4, T, Q>(Func(a.x, b), Func(a.y, b), Func(a.z, b), Func(a.w, b));
-		}
-	};
-}//namespace detail
-}//namespace glm
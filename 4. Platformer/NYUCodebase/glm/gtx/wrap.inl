@@ -1,57 +0,0 @@
-/// @ref gtx_wrap
-
-namespace glm
-{
-	template<length_t L, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<L, T, Q> clamp(vec<L, T, Q> const& Texcoord)
-	{
-		return glm::clamp(Texcoord, vec<L, T, Q>(0), vec<L, T, Q>(1));
-	}
-
-	template<typename genType>
-	GLM_FUNC_QUALIFIER genType clamp(genType const& Texcoord)
-	{
-		return clamp(vec<1, genType, defaultp>(Texcoord)).x;
-	}
-
-	template<length_t L, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<L, T, Q> repeat(vec<L, T, Q> const& Texcoord)
-	{
-		return glm::fract(Texcoord);
-	}
-
-	template<typename genType>
-	GLM_FUNC_QUALIFIER genType repeat(genType const& Texcoord)
-	{
-		return repeat(vec<1, genType, defaultp>(Texcoord)).x;
-	}
-
-	template<length_t L, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<L, T, Q> mirrorClamp(vec<L, T, Q> const& Texcoord)
-	{
-		return glm::fract(glm::abs(Texcoord));
-	}
-
-	template<typename genType>
-	GLM_FUNC_QUALIFIER genType mirrorClamp(genType const& Texcoord)
-	{
-		return mirrorClamp(vec<1, genType, defaultp>(Texcoord)).x;
-	}
-
-	template<length_t L, typename T, qualifier Q>
-	GLM_FUNC_QUALIFIER vec<L, T, Q> mirrorRepeat(vec<L, T, Q> const& Texcoord)
-	{
-		vec<L, T, Q> const Abs = glm::abs(Texcoord);
-		vec<L, T, Q> const Clamp = glm::mod(glm::floor(Abs), vec<L, T, Q>(2));
-		vec<L, T, Q> const Floor = glm::floor(Abs);
-		vec<L, T, Q> const Rest = Abs - Floor;
-		vec<L, T, Q> const Mirror = Clamp + Rest;
-		return mix(Rest, vec<L, T, Q>(1) - Rest, glm::greaterThanEqual(Mirror, vec<L, T, Q>(1)));
-	}
-
-	template<typename genType>
-	GLM_FUNC_QUALIFIER genType mirrorRepeat(genType const& Texcoord)
-	{
-		return mirrorRepeat(vec<1, genType, defaultp>(Texcoord)).x;
-	}
-}//namespace glm
@@ -1,9 +0,0 @@
-/// @ref core
-/// @file glm/mat2x4.hpp
-
-#pragma once
-#include "./ext/matrix_double2x4.hpp"
-#include "./ext/matrix_double2x4_precision.hpp"
-#include "./ext/matrix_float2x4.hpp"
-#include "./ext/matrix_float2x4_precision.hpp"
-
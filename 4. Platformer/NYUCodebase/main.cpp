@@ -7,13 +7,22 @@
 #include <SDL_image.h>
 
 #include "ShaderProgram.h"
+#include "Texture.h"
+#include "SheetSprite.h"
+#include "Text.h"
+#include "FrameArena.h"
+#include "InputQueue.h"
+#include "stb_image.h"	// stbi_info() for the micro-benchmarks
+#include "GLStats.h"
+#include "FramePacer.h"
+#include "FrameProfiler.h"
+#include "Benchmark.h"
+#include "MicroBenchmark.h"
+#include "JobSystem.h"
+#include "Trace.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
-// Load images in any format with STB_image
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-
 #ifdef _WINDOWS
 #define RESOURCE_FOLDER ""
 #else
@@ -25,6 +34,7 @@
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 using namespace std;
 
 #define FIXED_TIMESTEP 0.0166666f	// 60 FPS (1.0f/60.0f) (update sixty times a second)
@@ -34,12 +44,19 @@ using namespace std;
 #define SPRITE_COUNT_Y 8
 #define FRICTION 2.0f
 #define GRAVITY -2.0f
+#define MOVE_ACCELERATION 1.0f
+#define JUMP_VELOCITY 1.0f
+#define BOT_JUMP_FRAMES 40		// Frames between the benchmark player's jumps
 
 SDL_Window* displayWindow;
+FramePacer framePacer;
+FrameProfiler profiler;
+Benchmark benchmark;			// --benchmark menu|run: play a scripted scenario and report frame times
+bool benchmarkLevel = false;	// The run benchmark starts the level straight from the menu
+bool hiddenWindow = false;		// Benchmarks run without showing the window
 ShaderProgram texturedProgram;  // For textured polygons
 
 bool done = false;				// Game loop
-float lastFrameTicks = 0.0f;	// Set time to an initial value of 0
 float accumulator = 0.0f;
 
 int mapHeight;
@@ -49,62 +66,6 @@ unsigned int** mapData;
 GLuint asciiSpriteSheetTexture;
 GLuint arneSpriteSheetTexture;
 
-class SheetSprite {
-public:
-	SheetSprite();
-	SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size);
-	void Draw(ShaderProgram &program);
-
-	float u;
-	float v;
-	float width;
-	float height;
-	float size;
-	unsigned int textureID;
-};
-
-SheetSprite::SheetSprite() {}
-
-SheetSprite::SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size) {
-	this->textureID = textureID;
-	this->u = u;
-	this->v = v;
-	this->width = width;
-	this->height = height;
-	this->size = size;
-}
-
-void SheetSprite::Draw(ShaderProgram &program) {
-	float aspectRatio = width / height;
-	float vertices[] = {
-		-0.5f * size * aspectRatio, -0.5f * size,
-		 0.5f * size * aspectRatio,  0.5f * size,
-		-0.5f * size * aspectRatio,  0.5f * size,
-		 0.5f * size * aspectRatio,  0.5f * size,
-		-0.5f * size * aspectRatio, -0.5f * size,
-		 0.5f * size * aspectRatio, -0.5f * size
-	};
-	float texCoords[] = {
-		u, v + height,
-		u + width, v,
-		u, v,
-		u + width, v,
-		u, v + height,
-		u + width, v + height
-	};
-	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertices);
-	glEnableVertexAttribArray(program.positionAttribute);
-
-	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoords);
-	glEnableVertexAttribArray(program.texCoordAttribute);
-
-	glBindTexture(GL_TEXTURE_2D, textureID);
-
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glDisableVertexAttribArray(program.positionAttribute);
-	glDisableVertexAttribArray(program.texCoordAttribute);
-}
-
 enum EntityType { ENTITY_PLAYER, ENTITY_COIN, ENTITY_TILE };
 
 class Entity {
@@ -211,66 +172,11 @@ void Entity::ResolveCollisionY(Entity& otherEntity) {
 	velocity.y = 0.0f; // Reset
 }
 
-GLuint LoadTexture(const char *filePath) {
-	int w, h, comp;
-	unsigned char* image = stbi_load(filePath, &w, &h, &comp, STBI_rgb_alpha);
-	if (image == NULL) {
-		std::cout << "Unable to load image. Make sure the path is correct\n";
-		assert(false);
-	}
-	GLuint retTexture;
-	glGenTextures(1, &retTexture);
-	glBindTexture(GL_TEXTURE_2D, retTexture);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	stbi_image_free(image);
-	return retTexture;
-}
-
-void DrawText(ShaderProgram &program, int fontTexture, std::string text, float size, float spacing) {
-	float character_size = 1.0 / 16.0f;
-	std::vector<float> vertexData;
-	std::vector<float> texCoordData;
-	for (size_t i = 0; i < text.size(); i++) {
-		int spriteIndex = (int)text[i];
-		float texture_x = (float)(spriteIndex % 16) / 16.0f;
-		float texture_y = (float)(spriteIndex / 16) / 16.0f;
-		vertexData.insert(vertexData.end(), {
-			((size + spacing) * i) + (-0.5f * size),  0.5f * size,
-			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
-			((size + spacing) * i) +  (0.5f * size),  0.5f * size,
-			((size + spacing) * i) +  (0.5f * size), -0.5f * size,
-			((size + spacing) * i) +  (0.5f * size),  0.5f * size,
-			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
-		});
-		texCoordData.insert(texCoordData.end(), {
-			texture_x, texture_y,
-			texture_x, texture_y + character_size,
-			texture_x + character_size, texture_y,
-			texture_x + character_size, texture_y + character_size,
-			texture_x + character_size, texture_y,
-			texture_x, texture_y + character_size,
-		});
-	}
-	glBindTexture(GL_TEXTURE_2D, fontTexture);
-
-	// draw this data (use the .data() method of std::vector to get pointer to data)
-	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertexData.data());
-	glEnableVertexAttribArray(program.positionAttribute);
-
-	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoordData.data());
-	glEnableVertexAttribArray(program.texCoordAttribute);
-
-	// draw this yourself, use text.size() * 6 or vertexData.size()/2 to get number of vertices
-	glDrawArrays(GL_TRIANGLES, 0, 6 * (int)text.size());
-	glDisableVertexAttribArray(program.positionAttribute);
-	glDisableVertexAttribArray(program.texCoordAttribute);
-}
-
-void DrawTileMap(ShaderProgram &program, unsigned int spriteSheetTexture) {
-	vector<float> vertexData;
-	vector<float> texCoordData;
+// Appends two triangles per cell of the loaded map to the vertex and texture coordinate arrays
+void BuildTileMapMesh(ArenaVector<float> &vertexData, ArenaVector<float> &texCoordData) {
+	TRACE_SCOPE("BuildTileMapMesh");
+	vertexData.reserve(vertexData.size() + mapWidth * mapHeight * 12);
+	texCoordData.reserve(texCoordData.size() + mapWidth * mapHeight * 12);
 	for (int y = 0; y < mapHeight; y++) {
 		for (int x = 0; x < mapWidth; x++) {
 			float u = (float)(((int)mapData[y][x]) % SPRITE_COUNT_X) / (float)SPRITE_COUNT_X;
@@ -295,6 +201,12 @@ void DrawTileMap(ShaderProgram &program, unsigned int spriteSheetTexture) {
 			});
 		}
 	}
+}
+
+void DrawTileMap(ShaderProgram &program, unsigned int spriteSheetTexture) {
+	ArenaVector<float> vertexData;
+	ArenaVector<float> texCoordData;
+	BuildTileMapMesh(vertexData, texCoordData);
 	glBindTexture(GL_TEXTURE_2D, spriteSheetTexture);
 
 	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertexData.data());
@@ -325,6 +237,15 @@ void worldToTileCoordinates(float worldX, float worldY, int *gridX, int *gridY)
 }
 
 bool readHeader(std::ifstream &inputFileStream) {
+	// A map read before is replaced
+	if (mapData != NULL) {
+		for (int i = 0; i < mapHeight; ++i) {
+			delete[] mapData[i];
+		}
+		delete[] mapData;
+		mapData = NULL;
+	}
+
 	string line;
 	mapWidth = -1;
 	mapHeight = -1;
@@ -423,8 +344,9 @@ bool readEntityData(std::ifstream &inputFileStream) {
 	return true;
 }
 
-void readFlaremap() {
-	ifstream inputFileStream("flaremap.txt");
+void readFlaremap(const char *mapPath) {
+	TRACE_SCOPE("readFlaremap");
+	ifstream inputFileStream(mapPath);
 	string line;
 	while (getline(inputFileStream, line)) {
 		if (line == "[header]") {
@@ -444,7 +366,8 @@ void readFlaremap() {
 void SetupMainMenu() {}
 
 void SetupGameLevel() {
-	readFlaremap();
+	TRACE_SCOPE("SetupGameLevel");
+	readFlaremap("flaremap.txt");
 	DrawTileMap(texturedProgram, arneSpriteSheetTexture);
 
 	// Initialize player attributes
@@ -506,8 +429,13 @@ void SetupGameLevel() {
 }
 
 void Setup() {
+	TRACE_SCOPE("Setup");
 	SDL_Init(SDL_INIT_VIDEO);
-	displayWindow = SDL_CreateWindow("Platformer by Richard Shu", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 640, 360, SDL_WINDOW_OPENGL);
+	Uint32 windowFlags = SDL_WINDOW_OPENGL;
+	if (hiddenWindow) {
+		windowFlags |= SDL_WINDOW_HIDDEN;
+	}
+	displayWindow = SDL_CreateWindow("Platformer by Richard Shu", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 640, 360, windowFlags);
 	SDL_GLContext context = SDL_GL_CreateContext(displayWindow);
 	SDL_GL_MakeCurrent(displayWindow, context);
 
@@ -516,6 +444,16 @@ void Setup() {
 #endif
 
 	glViewport(0, 0, 640, 360);
+	framePacer.Setup(60);
+
+	// Count GL calls per render pass when GL_STATS or GL_STATS_CSV is set
+	glStats.Setup();
+
+	// A benchmark runs as fast as it can with the GL calls counted
+	if (benchmark.active) {
+		framePacer.SetTarget(FRAME_PACER_UNCAPPED);
+		glStats.enabled = true;
+	}
 
 	// Load shader program
 	texturedProgram.Load(RESOURCE_FOLDER"vertex_textured.glsl", RESOURCE_FOLDER"fragment_textured.glsl");
@@ -548,53 +486,77 @@ void Setup() {
 }
 
 void ProcessEvents() {
-	SDL_Event event;
-	while (SDL_PollEvent(&event)) {
-		if (event.type == SDL_QUIT || event.type == SDL_WINDOWEVENT_CLOSE) {
+	TRACE_SCOPE("Events");
+	inputQueue.Poll();
+	const vector<InputEvent> &events = inputQueue.Polled();
+	for (size_t i = 0; i < events.size(); i++) {
+		if (events[i].event.type == SDL_QUIT || events[i].event.type == SDL_WINDOWEVENT_CLOSE) {
 			done = true;
 		}
 	}
 
-	// Allow the player to move the spaceship left and right
-	const Uint8 *keys = SDL_GetKeyboardState(NULL);
+	// The menu doesn't tick, it takes its input once a frame
 	if (mode == MAIN_MENU) {
-		if (event.type == SDL_MOUSEBUTTONDOWN) {
+		inputQueue.BeginTick();
+		if (inputQueue.Clicked(NULL, NULL) || benchmarkLevel) {
 			mode = GAME_LEVEL;
 			SetupGameLevel();
 		}
 	}
-	else if (mode == GAME_LEVEL) {
-		// Move left
-		if (keys[SDL_SCANCODE_LEFT]) {
-			state.player.acceleration.x = -1.0f;
-		}
-		// Move right
-		else if (keys[SDL_SCANCODE_RIGHT]) {
-			state.player.acceleration.x = 1.0f;
-		}
-		else {
-			state.player.acceleration.x = 0.0f;
-		}
+}
 
-		// Jump
-		if (event.key.keysym.scancode == SDL_SCANCODE_UP) {
-			state.player.velocity.y = 1.0f;
-		}
+// Applies the input since the last tick, at the start of every tick of the level
+void ProcessInput() {
+	inputQueue.BeginTick();
+
+	// The benchmark player runs right across the map, jumping every BOT_JUMP_FRAMES frames
+	bool left = inputQueue.Down(SDL_SCANCODE_LEFT);
+	bool right = inputQueue.Down(SDL_SCANCODE_RIGHT);
+	bool jump = inputQueue.Pressed(SDL_SCANCODE_UP);
+	if (benchmark.active) {
+		left = false;
+		right = true;
+		jump = benchmark.frame % BOT_JUMP_FRAMES == 0;
+	}
+
+	// Move left
+	if (left) {
+		state.player.acceleration.x = -MOVE_ACCELERATION;
+	}
+	// Move right
+	else if (right) {
+		state.player.acceleration.x = MOVE_ACCELERATION;
+	}
+	else {
+		state.player.acceleration.x = 0.0f;
+	}
+
+	// Jump
+	if (jump) {
+		state.player.velocity.y = JUMP_VELOCITY;
 	}
 }
 
 void Update(float elapsed) {
+	TRACE_SCOPE("Update");
 	// Call each NONSTATIC entities' Update() method
 	state.player.Update(elapsed);
-	for (size_t i = 0; i < state.tiles.size(); i++) {
-		state.player.CollidesWith(state.tiles[i]);
-	}
-	for (size_t i = 0; i < state.coins.size(); i++) {
-		state.player.CollidesWith(state.coins[i]);
+	{
+		TRACE_SCOPE("Collisions");
+		for (size_t i = 0; i < state.tiles.size(); i++) {
+			state.player.CollidesWith(state.tiles[i]);
+		}
+		for (size_t i = 0; i < state.coins.size(); i++) {
+			state.player.CollidesWith(state.coins[i]);
+		}
 	}
+	TRACE_COUNTER("Tile count", state.tiles.size());
+	TRACE_COUNTER("Coin count", state.coins.size());
 }
 
 void RenderMainMenu() {
+	TRACE_SCOPE("Menu");
+	glStats.BeginPass("Menu");
 	glm::mat4 modelMatrix = glm::mat4(1.0f);
 	modelMatrix = glm::translate(modelMatrix, glm::vec3(-0.625f, 0.25f, 0.0f));
 	texturedProgram.SetModelMatrix(modelMatrix);
@@ -608,12 +570,24 @@ void RenderMainMenu() {
 
 void RenderGameLevel() {
 	// Loop through entities and call their draw methods
-	state.player.Draw(texturedProgram);
-	for (size_t i = 0; i < state.tiles.size(); i++) {
-		state.tiles[i].Draw(texturedProgram);
+	{
+		TRACE_SCOPE("Player");
+		glStats.BeginPass("Player");
+		state.player.Draw(texturedProgram);
 	}
-	for (size_t i = 0; i < state.coins.size(); i++) {
-		state.coins[i].Draw(texturedProgram);
+	{
+		TRACE_SCOPE("Tiles");
+		glStats.BeginPass("Tiles");
+		for (size_t i = 0; i < state.tiles.size(); i++) {
+			state.tiles[i].Draw(texturedProgram);
+		}
+	}
+	{
+		TRACE_SCOPE("Coins");
+		glStats.BeginPass("Coins");
+		for (size_t i = 0; i < state.coins.size(); i++) {
+			state.coins[i].Draw(texturedProgram);
+		}
 	}
 
 	// Allow scrolling by setting the view matrix to the inverse of the player's position coordinates
@@ -623,6 +597,7 @@ void RenderGameLevel() {
 }
 
 void Render() {
+	TRACE_SCOPE("Render");
 	glClear(GL_COLOR_BUFFER_BIT);
 	switch (mode) {
 		case MAIN_MENU:
@@ -632,38 +607,723 @@ void Render() {
 			RenderGameLevel();
 			break;
 	}
-	SDL_GL_SwapWindow(displayWindow);
+}
+
+// Level checking (run headless with --check-level <map> [air jumps] as part of level cooking)
+//
+// The player's possible jumps and falls are simulated once with Entity::Update and stored
+// as paths of grid cells relative to where they start. A standing cell is an empty cell
+// with a solid cell below it. Laying the paths over the map gives, for every standing cell,
+// the standing cells it can walk, jump or fall to and the coins it passes on the way; the
+// columns are split across the job system.
+//
+// The game lets the player jump again in mid-air, so each jump also records its apex, and
+// the cells some jump peaks in get the jumps that could start from there (found in waves,
+// one per air jump). The search runs over one layer for standing cells plus one per air
+// jump used, so a limited number of air jumps can be checked.
+//
+// A flood fill from the player's spawn then reports the coins that can never be collected
+// and the dead ends: standing cells you can reach but can't get back from, and pits you
+// can fall out of the map through.
+
+#define LEVEL_CHECK_RELEASE_STEP 10		// Ticks between the times a held direction is let go in the simulated arcs
+#define LEVEL_CHECK_COLUMN_CHUNK 64
+#define LEVEL_CHECK_MAX_AIR_JUMPS 8
+
+// One simulated path of the player's center, as cell offsets from its first cell
+struct Trajectory {
+	vector<int> dx;
+	vector<int> dy;
+	vector<char> falling;
+	int apex = -1;		// First step where the player is falling, or -1 for falls
+};
+
+enum LevelEdgeType { EDGE_LAND, EDGE_APEX, EDGE_PIT };
+
+struct LevelEdge {
+	int from;
+	int to;		// For EDGE_PIT, the column the path falls out of the map through
+	LevelEdgeType type;
+};
+
+// Edges leaving a group of cells (the standing cells of a column, or a batch of apex cells)
+struct LevelEdges {
+	vector<LevelEdge> edges;
+	vector<LevelEdge> coins;	// to is a coin index
+};
+
+struct LevelCheck {
+	vector<Trajectory> jumps;
+	vector<Trajectory> falls;
+	vector<int> coinAt;		// Coin index for each cell, or -1
+	vector<char> cellFlags;	// CELL_SOLID and CELL_STANDING for each cell, copied out of mapData
+	vector<LevelEdges> standing;	// One per column
+	vector<LevelEdges> air;			// One per chunk of apex cells
+	bool airJumps;
+};
+
+#define CELL_SOLID 1
+#define CELL_STANDING 2
+
+// Everything outside the map is solid, paths check for falling out through the bottom first
+bool isSolid(const LevelCheck &check, int x, int y) {
+	return x < 0 || x >= mapWidth || y < 0 || y >= mapHeight || (check.cellFlags[y * mapWidth + x] & CELL_SOLID);
+}
+
+bool isStanding(const LevelCheck &check, int x, int y) {
+	return x >= 0 && x < mapWidth && y >= 0 && y < mapHeight && (check.cellFlags[y * mapWidth + x] & CELL_STANDING);
+}
+
+int worldToCellX(float worldX) {
+	return (int)floorf((worldX + 1.777f) / TILE_SIZE + 0.5f);
+}
+
+int worldToCellY(float worldY) {
+	return (int)floorf((1.0f - worldY) / TILE_SIZE + 0.5f);
+}
+
+// Simulates the player from rest with the direction held until releaseTick and records the
+// cells its center passes through until it drops below the bottom of the map
+Trajectory simulateTrajectory(float startVelocityY, float direction, int releaseTick) {
+	Entity probe;
+	probe.position = glm::vec3(0.0f, 0.0f, 0.0f);
+	probe.velocity = glm::vec3(0.0f, startVelocityY, 0.0f);
+	probe.acceleration = glm::vec3(direction * MOVE_ACCELERATION, GRAVITY, 0.0f);
+
+	Trajectory trajectory;
+	int cellX = 0;
+	int cellY = 0;
+	for (int tick = 0; cellY <= mapHeight; tick++) {
+		if (tick == releaseTick) {
+			probe.acceleration.x = 0.0f;
+		}
+		probe.Update(FIXED_TIMESTEP);
+		int nextX = (int)floorf(probe.position.x / TILE_SIZE + 0.5f);
+		int nextY = (int)floorf(-probe.position.y / TILE_SIZE + 0.5f);
+
+		// Fast falls can cover more than one cell per tick, so fill in the cells between
+		while (cellX != nextX || cellY != nextY) {
+			if (cellX != nextX) {
+				cellX += nextX > cellX ? 1 : -1;
+			}
+			else {
+				cellY += nextY > cellY ? 1 : -1;
+			}
+			trajectory.dx.push_back(cellX);
+			trajectory.dy.push_back(cellY);
+			trajectory.falling.push_back(probe.velocity.y < 0.0f);
+			if (startVelocityY > 0.0f && trajectory.apex < 0 && probe.velocity.y < 0.0f) {
+				trajectory.apex = (int)trajectory.dx.size() - 1;
+			}
+		}
+	}
+	return trajectory;
+}
+
+void simulateTrajectories(vector<Trajectory> &trajectories, float startVelocityY) {
+	trajectories.push_back(simulateTrajectory(startVelocityY, 0.0f, 0));
+	for (int direction = -1; direction <= 1; direction += 2) {
+		for (int releaseTick = LEVEL_CHECK_RELEASE_STEP; releaseTick <= 6 * LEVEL_CHECK_RELEASE_STEP; releaseTick += LEVEL_CHECK_RELEASE_STEP) {
+			trajectories.push_back(simulateTrajectory(startVelocityY, (float)direction, releaseTick));
+		}
+		trajectories.push_back(simulateTrajectory(startVelocityY, (float)direction, -1));
+	}
+}
+
+void addEdge(vector<LevelEdge> &edges, int from, int to, LevelEdgeType type) {
+	LevelEdge edge = { from, to, type };
+	edges.push_back(edge);
+}
+
+void touchCoin(LevelCheck &check, int from, int x, int y, vector<LevelEdge> &coins) {
+	int coin = check.coinAt[y * mapWidth + x];
+	if (coin >= 0) {
+		addEdge(coins, from, coin, EDGE_LAND);
+	}
+}
+
+// Lays one path over the map from (startX, startY). The path ends on the first standing cell
+// it reaches while falling, or in a pit if it drops out of the bottom of the map. Running into
+// a ceiling ends the rise there (an early apex) and running into anything makes the player
+// drop straight down.
+void followTrajectory(LevelCheck &check, const Trajectory &trajectory, int from, int startX, int startY, vector<LevelEdge> &edges, vector<LevelEdge> &coins) {
+	int x = startX;
+	int y = startY;
+	bool apexFound = false;
+	for (size_t i = 0; i < trajectory.dx.size(); i++) {
+		int nextX = startX + trajectory.dx[i];
+		int nextY = startY + trajectory.dy[i];
+		if (nextY >= mapHeight) {
+			addEdge(edges, from, x, EDGE_PIT); // Fell out of the map
+			return;
+		}
+		if (isSolid(check, nextX, nextY)) {
+			break;
+		}
+		x = nextX;
+		y = nextY;
+		touchCoin(check, from, x, y, coins);
+		if ((int)i == trajectory.apex && check.airJumps) {
+			addEdge(edges, from, y * mapWidth + x, EDGE_APEX);
+			apexFound = true;
+		}
+		if (trajectory.falling[i] && isStanding(check, x, y)) {
+			addEdge(edges, from, y * mapWidth + x, EDGE_LAND);
+			return;
+		}
+	}
+	if (trajectory.apex >= 0 && !apexFound && check.airJumps) {
+		addEdge(edges, from, y * mapWidth + x, EDGE_APEX);
+	}
+	while (y + 1 < mapHeight && !isSolid(check, x, y + 1)) {
+		y++;
+		touchCoin(check, from, x, y, coins);
+	}
+	if (y + 1 >= mapHeight) {
+		addEdge(edges, from, x, EDGE_PIT); // Fell out of the map
+		return;
+	}
+	addEdge(edges, from, y * mapWidth + x, EDGE_LAND);
+}
+
+void checkColumn(LevelCheck &check, int x) {
+	LevelEdges &column = check.standing[x];
+	for (int y = 0; y < mapHeight; y++) {
+		if (!isStanding(check, x, y)) {
+			continue;
+		}
+		int from = y * mapWidth + x;
+		touchCoin(check, from, x, y, column.coins);
+		for (size_t i = 0; i < check.jumps.size(); i++) {
+			followTrajectory(check, check.jumps[i], from, x, y, column.edges, column.coins);
+		}
+		// Walk to the next cell, or off the ledge and fall from there
+		for (int side = -1; side <= 1; side += 2) {
+			if (isSolid(check, x + side, y)) {
+				continue;
+			}
+			if (isStanding(check, x + side, y)) {
+				addEdge(column.edges, from, from + side, EDGE_LAND);
+				continue;
+			}
+			touchCoin(check, from, x + side, y, column.coins);
+			for (size_t i = 0; i < check.falls.size(); i++) {
+				followTrajectory(check, check.falls[i], from, x + side, y, column.edges, column.coins);
+			}
+		}
+	}
+}
+
+// Air jumps from an apex in cell
+void checkApex(LevelCheck &check, int cell, LevelEdges &out) {
+	for (size_t i = 0; i < check.jumps.size(); i++) {
+		followTrajectory(check, check.jumps[i], cell, cell % mapWidth, cell / mapWidth, out.edges, out.coins);
+	}
+}
+
+// Queues the apex cells of edges that haven't been checked yet
+void queueApexes(const vector<LevelEdge> &edges, vector<char> &queued, vector<int> &apexes) {
+	for (size_t i = 0; i < edges.size(); i++) {
+		if (edges[i].type == EDGE_APEX && !queued[edges[i].to]) {
+			queued[edges[i].to] = 1;
+			apexes.push_back(edges[i].to);
+		}
+	}
+}
+
+// Marks every node reachable from start by following the edges in offsets/targets (compressed rows)
+void floodFill(int start, const vector<int> &offsets, const vector<int> &targets, vector<char> &reached) {
+	vector<int> open;
+	reached[start] = 1;
+	open.push_back(start);
+	while (!open.empty()) {
+		int node = open.back();
+		open.pop_back();
+		for (int i = offsets[node]; i < offsets[node + 1]; i++) {
+			if (!reached[targets[i]]) {
+				reached[targets[i]] = 1;
+				open.push_back(targets[i]);
+			}
+		}
+	}
+}
+
+void buildRows(const vector<LevelEdge> &edges, bool reverse, int numNodes, vector<int> &offsets, vector<int> &targets) {
+	offsets.assign(numNodes + 1, 0);
+	for (size_t i = 0; i < edges.size(); i++) {
+		offsets[(reverse ? edges[i].to : edges[i].from) + 1]++;
+	}
+	for (int node = 0; node < numNodes; node++) {
+		offsets[node + 1] += offsets[node];
+	}
+	vector<int> next(offsets.begin(), offsets.end() - 1);
+	targets.resize(edges.size());
+	for (size_t i = 0; i < edges.size(); i++) {
+		int source = reverse ? edges[i].to : edges[i].from;
+		targets[next[source]++] = reverse ? edges[i].from : edges[i].to;
+	}
+}
+
+// Copies cell edges into the layered graph. Nodes are layer * numCells + cell: layer 0 is
+// standing and layer k is at an apex after k - 1 air jumps, with air jumps still to spare.
+void addLayeredEdges(const vector<LevelEdge> &cellEdges, int fromLayer, int airJumps, int numCells, vector<LevelEdge> &edges) {
+	for (size_t i = 0; i < cellEdges.size(); i++) {
+		const LevelEdge &edge = cellEdges[i];
+		if (edge.type == EDGE_LAND) {
+			addEdge(edges, fromLayer * numCells + edge.from, edge.to, EDGE_LAND);
+		}
+		else if (edge.type == EDGE_APEX && fromLayer + 1 <= airJumps) {
+			addEdge(edges, fromLayer * numCells + edge.from, (fromLayer + 1) * numCells + edge.to, EDGE_APEX);
+		}
+	}
+}
+
+// Returns the number of problems found, so level cooking can fail on a non-zero exit code
+int CheckLevel(const char *mapPath, int airJumps) {
+	TRACE_SCOPE("CheckLevel");
+	Uint64 startTicks = SDL_GetPerformanceCounter();
+	readFlaremap(mapPath);
+	if (mapData == NULL) {
+		std::cout << "Unable to read map " << mapPath << "\n";
+		return 1;
+	}
+	airJumps = std::max(0, std::min(airJumps, LEVEL_CHECK_MAX_AIR_JUMPS));
+	int numCells = mapWidth * mapHeight;
+	int numNodes = numCells * (airJumps + 1);
+
+	LevelCheck check;
+	check.airJumps = airJumps > 0;
+	simulateTrajectories(check.jumps, JUMP_VELOCITY);
+	simulateTrajectories(check.falls, 0.0f);
+
+	check.cellFlags.assign(numCells, 0);
+	for (int y = 0; y < mapHeight; y++) {
+		for (int x = 0; x < mapWidth; x++) {
+			if (mapData[y][x] != 0) {
+				check.cellFlags[y * mapWidth + x] = CELL_SOLID;
+			}
+			else if (y + 1 < mapHeight && mapData[y + 1][x] != 0) {
+				check.cellFlags[y * mapWidth + x] = CELL_STANDING;
+			}
+		}
+	}
+
+	// Entities are placed at tile centers, so their world positions map straight back to cells
+	check.coinAt.assign(numCells, -1);
+	for (size_t i = 0; i < state.coins.size(); i++) {
+		int x = worldToCellX(state.coins[i].position.x);
+		int y = worldToCellY(state.coins[i].position.y);
+		if (x >= 0 && x < mapWidth && y >= 0 && y < mapHeight) {
+			check.coinAt[y * mapWidth + x] = (int)i;
+		}
+	}
+
+	JobSystem jobSystem;
+	jobSystem.Setup(0);
+	check.standing.resize(mapWidth);
+	jobSystem.ParallelFor(mapWidth, LEVEL_CHECK_COLUMN_CHUNK, [&](size_t begin, size_t end, int worker) {
+		for (size_t x = begin; x < end; x++) {
+			checkColumn(check, (int)x);
+		}
+	});
+
+	// Wave k checks the apexes reached with k - 1 air jumps. Apex cells only depend on the map,
+	// so each is checked once, in the first wave that reaches it.
+	vector<char> queued(numCells, 0);
+	vector<int> apexes;
+	for (int x = 0; x < mapWidth; x++) {
+		queueApexes(check.standing[x].edges, queued, apexes);
+	}
+	size_t waveStart = 0;
+	for (int wave = 1; wave <= airJumps && waveStart < apexes.size(); wave++) {
+		size_t waveEnd = apexes.size();
+		size_t firstChunk = check.air.size();
+		check.air.resize(firstChunk + (waveEnd - waveStart + LEVEL_CHECK_COLUMN_CHUNK - 1) / LEVEL_CHECK_COLUMN_CHUNK);
+		jobSystem.ParallelFor(waveEnd - waveStart, LEVEL_CHECK_COLUMN_CHUNK, [&](size_t begin, size_t end, int worker) {
+			LevelEdges &out = check.air[firstChunk + begin / LEVEL_CHECK_COLUMN_CHUNK];
+			for (size_t i = begin; i < end; i++) {
+				checkApex(check, apexes[waveStart + i], out);
+			}
+		});
+		if (wave < airJumps) {
+			for (size_t chunk = firstChunk; chunk < check.air.size(); chunk++) {
+				queueApexes(check.air[chunk].edges, queued, apexes);
+			}
+		}
+		waveStart = waveEnd;
+	}
+	jobSystem.Shutdown();
+
+	// The spawn drops straight down to the first standing cell
+	int spawnX = worldToCellX(state.player.position.x);
+	int spawnY = worldToCellY(state.player.position.y);
+	vector<LevelEdge> spawnEdges;
+	vector<LevelEdge> spawnCoins;
+	if (!isSolid(check, spawnX, spawnY)) {
+		followTrajectory(check, Trajectory(), numCells, spawnX, spawnY, spawnEdges, spawnCoins);
+	}
+	if (spawnEdges.empty() || spawnEdges[0].type == EDGE_PIT) {
+		std::cout << "The player spawn at " << spawnX << "," << spawnY << " has no floor below it\n";
+		return 1;
+	}
+	int start = spawnEdges[0].to;
+
+	vector<LevelEdge> edges;
+	for (int x = 0; x < mapWidth; x++) {
+		addLayeredEdges(check.standing[x].edges, 0, airJumps, numCells, edges);
+	}
+	for (size_t chunk = 0; chunk < check.air.size(); chunk++) {
+		for (int layer = 1; layer <= airJumps; layer++) {
+			addLayeredEdges(check.air[chunk].edges, layer, airJumps, numCells, edges);
+		}
+	}
+
+	vector<int> offsets;
+	vector<int> targets;
+	vector<char> reachable(numNodes, 0);
+	buildRows(edges, false, numNodes, offsets, targets);
+	floodFill(start, offsets, targets, reachable);
+	vector<char> returnable(numNodes, 0);
+	buildRows(edges, true, numNodes, offsets, targets);
+	floodFill(start, offsets, targets, returnable);
+
+	vector<char> collectable(state.coins.size(), 0);
+	for (size_t i = 0; i < spawnCoins.size(); i++) {
+		collectable[spawnCoins[i].to] = 1;
+	}
+	for (int x = 0; x < mapWidth; x++) {
+		const vector<LevelEdge> &coins = check.standing[x].coins;
+		for (size_t i = 0; i < coins.size(); i++) {
+			if (reachable[coins[i].from]) {
+				collectable[coins[i].to] = 1;
+			}
+		}
+	}
+	for (size_t chunk = 0; chunk < check.air.size(); chunk++) {
+		const vector<LevelEdge> &coins = check.air[chunk].coins;
+		for (size_t i = 0; i < coins.size(); i++) {
+			for (int layer = 1; layer <= airJumps; layer++) {
+				if (reachable[layer * numCells + coins[i].from]) {
+					collectable[coins[i].to] = 1;
+				}
+			}
+		}
+	}
+
+	int problems = 0;
+	for (size_t i = 0; i < state.coins.size(); i++) {
+		if (!collectable[i]) {
+			std::cout << "Unreachable coin at " << worldToCellX(state.coins[i].position.x) << "," << worldToCellY(state.coins[i].position.y) << "\n";
+			problems++;
+		}
+	}
+
+	// The game never brings back a player who fell out of the map, so every pit reached is a dead end
+	vector<char> pits(mapWidth, 0);
+	for (int x = 0; x < mapWidth; x++) {
+		const vector<LevelEdge> &cellEdges = check.standing[x].edges;
+		for (size_t i = 0; i < cellEdges.size(); i++) {
+			if (cellEdges[i].type == EDGE_PIT && reachable[cellEdges[i].from]) {
+				pits[cellEdges[i].to] = 1;
+			}
+		}
+	}
+	for (size_t chunk = 0; chunk < check.air.size(); chunk++) {
+		const vector<LevelEdge> &cellEdges = check.air[chunk].edges;
+		for (size_t i = 0; i < cellEdges.size(); i++) {
+			for (int layer = 1; layer <= airJumps; layer++) {
+				if (cellEdges[i].type == EDGE_PIT && reachable[layer * numCells + cellEdges[i].from]) {
+					pits[cellEdges[i].to] = 1;
+				}
+			}
+		}
+	}
+	for (int x = 0; x < mapWidth; x++) {
+		if (pits[x] && (x == 0 || !pits[x - 1])) {
+			int end = x;
+			while (end + 1 < mapWidth && pits[end + 1]) {
+				end++;
+			}
+			std::cout << "Dead end: pit at columns " << x << "-" << end << "\n";
+			problems++;
+		}
+	}
+
+	// Every other cell the player reaches is a dead end if it can't lead back to the spawn. The
+	// spawn itself is one if all its paths leave the map or land back on it.
+	bool spawnStuck = true;
+	for (int cell = 0; cell < numCells; cell++) {
+		if (reachable[cell] && cell != start) {
+			spawnStuck = false;
+		}
+	}
+	int standingCells = 0;
+	int reachableCells = 0;
+	for (int cell = 0; cell < numCells; cell++) {
+		if (!isStanding(check, cell % mapWidth, cell / mapWidth)) {
+			continue;
+		}
+		standingCells++;
+		if (reachable[cell]) {
+			reachableCells++;
+			if (!returnable[cell] || (cell == start && spawnStuck)) {
+				std::cout << "Dead end at " << cell % mapWidth << "," << cell / mapWidth << "\n";
+				problems++;
+			}
+		}
+	}
+
+	float ms = (float)((SDL_GetPerformanceCounter() - startTicks) * 1000.0 / SDL_GetPerformanceFrequency());
+	std::cout << mapPath << ": " << mapWidth << "x" << mapHeight << " with " << airJumps << " air jumps, "
+		<< reachableCells << "/" << standingCells << " standing cells reachable, "
+		<< state.coins.size() << " coins, " << problems << " problems (" << ms << " ms)\n";
+	return problems;
 }
 
 void Cleanup() {
 	
 }
 
+// Micro-benchmarks (run with --microbench [results.csv])
+//
+// Times the functions the game leans on every frame or every level load, one at a time and
+// over a sweep of input sizes, so a change to one of them can be measured on its own.
+// The maps are generated, written next to the game and read back, and removed afterwards.
+
+#define MICRO_BENCHMARK_MAP "microbench_map.txt"
+
+// Writes a flaremap with a floor, scattered platforms and a coin every eighth column
+void writeTestMap(const char *path, int width, int height) {
+	ofstream file(path);
+	file << "[header]\nwidth=" << width << "\nheight=" << height << "\ntilewidth=16\ntileheight=16\n\n[layer]\ntype=Tile Layer 1\ndata=\n";
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			bool solid = y == height - 1 || (x * 7 + y * 3) % 11 == 0;
+			file << (solid ? 2 : 0) << (x + 1 < width || y + 1 < height ? "," : "");
+		}
+		file << "\n";
+	}
+	file << "\n[ObjectsLayer]\ntype=Player\nlocation=1," << height - 2 << ",1,1\n\n";
+	for (int x = 4; x < width; x += 8) {
+		file << "[ObjectsLayer]\ntype=Coin\nlocation=" << x << "," << height - 2 << ",1,1\n\n";
+	}
+}
+
+int RunMicroBenchmarks(const char *csvPath) {
+	hiddenWindow = true;
+	Setup();
+	MicroBenchmark bench;
+
+	// The player against a row of tiles it doesn't touch, the common case in Update()
+	int entityCounts[] = { 16, 256, 4096 };
+	for (size_t s = 0; s < sizeof(entityCounts) / sizeof(entityCounts[0]); s++) {
+		int count = entityCounts[s];
+		Entity player;
+		player.sprite = SheetSprite(arneSpriteSheetTexture, 0.0f, 0.0f, 16.0f / 256.0f, 16.0f / 128.0f, 0.15f);
+		player.position = glm::vec3(0.0f, 0.5f, 0.0f);
+		vector<Entity> tiles(count, player);
+		for (int i = 0; i < count; i++) {
+			tiles[i].position = glm::vec3(i * TILE_SIZE, -0.5f, 0.0f);
+			tiles[i].entityType = ENTITY_TILE;
+		}
+		bench.Run("Entity::CollidesWith", count, count, "tests", [&]() {
+			int hits = 0;
+			for (size_t i = 0; i < tiles.size(); i++) {
+				hits += player.CollidesWith(tiles[i]);
+			}
+			return hits;
+		});
+	}
+
+	// Fresh arrays from a reset arena every time, as DrawText() builds them in a frame
+	int textLengths[] = { 1, 16, 256, 4096 };
+	for (size_t s = 0; s < sizeof(textLengths) / sizeof(textLengths[0]); s++) {
+		int length = textLengths[s];
+		string text;
+		for (int i = 0; i < length; i++) {
+			text += (char)('A' + i % 26);
+		}
+		bench.Run("DrawText vertices", length, length, "chars", [&]() {
+			frameArena.Reset();
+			ArenaVector<float> vertexData;
+			ArenaVector<float> texCoordData;
+			BuildTextMesh(text.c_str(), 0.1f, -0.05f, vertexData, texCoordData);
+			return vertexData.size();
+		});
+	}
+
+	int mapSizes[] = { 16, 64, 256 };
+	for (size_t s = 0; s < sizeof(mapSizes) / sizeof(mapSizes[0]); s++) {
+		int size = mapSizes[s];
+		writeTestMap(MICRO_BENCHMARK_MAP, size, size);
+		bench.Run("readFlaremap", size, size * size, "tiles", [&]() {
+			readFlaremap(MICRO_BENCHMARK_MAP);
+			state.coins.clear();
+			return mapData[mapHeight - 1][0];
+		});
+		bench.Run("DrawTileMap mesh", size, size * size, "tiles", [&]() {
+			frameArena.Reset();
+			ArenaVector<float> vertexData;
+			ArenaVector<float> texCoordData;
+			BuildTileMapMesh(vertexData, texCoordData);
+			return vertexData.size();
+		});
+	}
+	remove(MICRO_BENCHMARK_MAP);
+
+	const char *textures[] = { RESOURCE_FOLDER"ascii_spritesheet.png", RESOURCE_FOLDER"arne_spritesheet.png" };
+	for (size_t s = 0; s < sizeof(textures) / sizeof(textures[0]); s++) {
+		const char *path = textures[s];
+		int w, h, comp;
+		if (!stbi_info(path, &w, &h, &comp)) {
+			continue;
+		}
+		bench.Run("LoadTexture", w * h, w * h, "pixels", [&]() {
+			GLuint texture = LoadTexture(path);
+			glDeleteTextures(1, &texture);
+			return texture;
+		});
+	}
+
+	// One model matrix per entity, as Entity::Draw() does
+	int drawCounts[] = { 1, 64, 1024 };
+	for (size_t s = 0; s < sizeof(drawCounts) / sizeof(drawCounts[0]); s++) {
+		int count = drawCounts[s];
+		vector<glm::vec3> positions(count);
+		for (int i = 0; i < count; i++) {
+			positions[i] = glm::vec3(i * TILE_SIZE, (i % 16) * -TILE_SIZE, 0.0f);
+		}
+		glm::vec3 size(2.0f, 1.0f, 1.0f);
+		bench.Run("translate+scale matrix", count, count, "matrices", [&]() {
+			float sum = 0.0f;
+			for (int i = 0; i < count; i++) {
+				glm::mat4 modelMatrix = glm::mat4(1.0f);
+				modelMatrix = glm::translate(modelMatrix, positions[i]);
+				modelMatrix = glm::scale(modelMatrix, size);
+				sum += modelMatrix[3][0] + modelMatrix[0][0];
+			}
+			return sum;
+		});
+		glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), positions[count - 1]);
+		bench.Run("ShaderProgram::SetModelMatrix", count, count, "calls", [&]() {
+			for (int i = 0; i < count; i++) {
+				texturedProgram.SetModelMatrix(modelMatrix);
+			}
+			return count;
+		});
+		bench.Run("ShaderProgram::SetColor", count, count, "calls", [&]() {
+			for (int i = 0; i < count; i++) {
+				texturedProgram.SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+			}
+			return count;
+		});
+	}
+
+#ifdef TRACING
+	// What every TRACE_SCOPE in the game costs when tracing is built in: two timestamps and a
+	// write into this thread's ring (the ring wraps, so the run never runs out of room)
+	int scopeCounts[] = { 1, 64 };
+	for (size_t s = 0; s < sizeof(scopeCounts) / sizeof(scopeCounts[0]); s++) {
+		int count = scopeCounts[s];
+		bench.Run("TRACE_SCOPE", count, count, "scopes", [&]() {
+			for (int i = 0; i < count; i++) {
+				TRACE_SCOPE("MicroBenchmark");
+			}
+			return count;
+		});
+		// The same without the timestamps, to tell the ring's share from the clock's
+		bench.Run("TraceRecordScope", count, count, "scopes", [&]() {
+			for (int i = 0; i < count; i++) {
+				TraceRecordScope("MicroBenchmark", i, i + 1);
+			}
+			return count;
+		});
+	}
+#endif
+
+	int result = 0;
+	if (csvPath != NULL && !bench.WriteCsv(csvPath)) {
+		result = 1;
+	}
+	Cleanup();
+	SDL_Quit();
+	return result;
+}
+
 int main(int argc, char *argv[])
 {
+	// The game allows any number of air jumps; one is the default for checking levels
+	if (argc >= 3 && string(argv[1]) == "--check-level") {
+		TraceSetup("check_level_trace.json");
+		int problems = CheckLevel(argv[2], argc >= 4 ? atoi(argv[3]) : 1);
+		TraceFlush();
+		return problems;
+	}
+	if (argc >= 2 && string(argv[1]) == "--microbench") {
+		return RunMicroBenchmarks(argc >= 3 ? argv[2] : NULL);
+	}
+	if (benchmark.ParseArguments(argc, argv)) {
+		hiddenWindow = true;
+		benchmarkLevel = benchmark.scenario == "run";
+		if (benchmark.scenario != "menu" && !benchmarkLevel) {
+			std::cout << "Unknown benchmark scenario " << benchmark.scenario << " (use menu or run)\n";
+			return 1;
+		}
+	}
+	TraceSetup("platformer_trace.json");
 	Setup();
 	while (!done) {
-		ProcessEvents();
-
+		TRACE_SCOPE("Frame");
 		// Calculate elapsed time
-		float ticks = (float)SDL_GetTicks() / 1000.0f;
-		float elapsed = ticks - lastFrameTicks;
-		lastFrameTicks = ticks; // Reset
+		float elapsed = framePacer.BeginFrame();
+		if (benchmark.active) {
+			elapsed = FIXED_TIMESTEP;	// One tick per frame, however long the frame took
+		}
+		profiler.BeginFrame();
+		frameArena.Reset();	// Scratch memory of the last frame is free again
+
+		ProcessEvents();
+		profiler.EndPhase(PHASE_EVENTS);
 
 		// Use fixed timestep (instead of variable timestep)
+		// The frame pacer sleeps between frames, so there is no need to spin until a whole step has passed
 		elapsed += accumulator;
-		if (elapsed < FIXED_TIMESTEP) {
-			accumulator = elapsed;
-			continue;
-		}
 		while (elapsed >= FIXED_TIMESTEP) {
+			if (mode == GAME_LEVEL) {
+				ProcessInput();
+			}
 			Update(FIXED_TIMESTEP);
 			elapsed -= FIXED_TIMESTEP;
 		}
 		accumulator = elapsed;
+		profiler.EndPhase(PHASE_UPDATE);
 		Render();
+		profiler.EndPhase(PHASE_RENDER);
+		{
+			TRACE_SCOPE("Swap");
+			SDL_GL_SwapWindow(displayWindow);
+		}
+		profiler.EndPhase(PHASE_SWAP);
+		glStats.EndFrame();
+		profiler.EndFrame();
+		if (benchmark.active) {
+			benchmark.RecordFrame(profiler, glStats);
+			if (benchmark.Done()) {
+				done = true;
+			}
+		}
+		{
+			TRACE_SCOPE("Pace");
+			framePacer.EndFrame();
+		}
     }
+	framePacer.PrintStats();
+	profiler.PrintStats();
+	frameArena.PrintStats();
+	inputQueue.PrintStats();
+	int result = benchmark.active ? benchmark.Finish("Platformer") : 0;
+	TraceFlush();
 	Cleanup();
 	SDL_Quit();
-    return 0;
+    return result;
 }
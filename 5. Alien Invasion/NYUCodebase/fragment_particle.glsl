@@ -0,0 +1,9 @@
+
+uniform sampler2D diffuse;
+varying vec2 texCoordVar;
+varying float fadeVar;
+
+void main() {
+    vec4 color = texture2D(diffuse, texCoordVar);
+    gl_FragColor = vec4(color.rgb, color.a * fadeVar);
+}
@@ -1,6 +0,0 @@
-/// @ref core
-
-namespace glm
-{
-
-}//namespace glm
@@ -7,14 +7,27 @@
 #include <SDL_image.h>
 
 #include "ShaderProgram.h"
+#include "Texture.h"
+#include "SheetSprite.h"
+#include "Text.h"
+#include "FrameArena.h"
+#include "InputQueue.h"
+#include "GLStats.h"
+#include "GPUTimer.h"
+#include "BoxOverlap.h"
+#include "SweptBox.h"
+#include "FramePacer.h"
+#include "FrameProfiler.h"
+#include "JobSystem.h"
+#include "Random.h"
+#include "Replay.h"
+#include "Benchmark.h"
+#include "StressTest.h"
+#include "Trace.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include <SDL_mixer.h>	// For background music
 
-// Load images in any format with STB_image
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-
 #ifdef _WINDOWS
 #define RESOURCE_FOLDER ""
 #else
@@ -26,18 +39,45 @@
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <iomanip>
+#include <algorithm>
 using namespace std;
 
 #define FIXED_TIMESTEP 0.0166666f	// 60 FPS (1.0f/60.0f) (update sixty times a second)
+#define TICK_RATE_MIN 10			// Bullets are swept, so slower ticks still register hits
 #define MAX_TIMESTEPS 6
-#define MAX_BULLETS 50
-#define MAX_PARTICLES 20
+#define MAX_BULLETS 50		// Per player, reserved up front so firing never allocates
+#define ENEMY_RESERVE 512	// Enemies reserved up front, enough for the waves anyone reaches
+#define ARENA_EDGE 2.2f		// Bullets past this are dropped (enemies spawn at +-2.0)
+#define MAX_PARTICLES 512	// Explosion particles alive at once, the oldest are reused when more are needed
+#define BULLET_CHUNK 8		// Bullets per job (each one is tested against every enemy)
+#define ENEMY_CHUNK 1024	// Enemies per job, a multiple of 32 so chunks never share a hit mask word
+#define BOT_STEP_TICKS 45	// Ticks a benchmark bot walks in one direction before turning
+#define STRESS_ENEMIES_PER_STEP 64		// Load a stress test adds every step
+#define STRESS_BULLETS_PER_STEP 8
+#define STRESS_PARTICLES_PER_STEP 256
 
 SDL_Window* displayWindow;
+FramePacer framePacer;
+FrameProfiler profiler;
+bool showProfiler = false;	// Toggled with F3
+bool gpuTimingAlways = false;	// GPU_TIMER or a benchmark keeps GPU timing on with the profiler hidden
+JobSystem jobSystem;
+Random sessionRandom;	// Hands out a stream to every system that needs random numbers
+Replay replay;
+const char *recordPath = NULL;	// --record <file>: save each game's input
+bool playingReplay = false;		// --replay <file>: play a saved game instead of reading the keyboard
+bool fastReplay = false;		// --fast: run replay ticks back to back instead of in real time
+Uint64 replayStart;
+Benchmark benchmark;	// --benchmark menu|wave<N>: play a scripted scenario and report frame times
+int benchmarkWave = 0;	// Wave a game benchmark starts at, 0 for the menu
+StressTest stress;		// --stress: raise the load every second until a frame no longer fits the budget
+bool invulnerable = false;	// Players survive everything, so a benchmark always runs to the end
 SDL_GLContext context;
 ShaderProgram program;
 ShaderProgram texturedProgram;  // For textured polygons
-const Uint8 *keys;
+ShaderProgram particleProgram;  // Textured with a per-vertex fade
+GLuint particleFadeAttribute;
 glm::mat4 projectionMatrix, viewMatrix;
 
 Mix_Music* backgroundMusic;
@@ -47,6 +87,24 @@ enum GameMode { MAIN_MENU, GAME_LEVEL, GAME_OVER };
 enum Direction { LEFT, RIGHT, UP, DOWN };
 enum EntityType { PLAYER, ENEMY, BULLET, PARTICLE, BUTTON};
 
+// Buttons held during a tick. The simulation only sees these bits, never the keyboard,
+// so a tick can be fed from a replay exactly as it was played.
+enum Button {
+	BUTTON_BETTY_LEFT = 1 << 0,		// Arrow keys, M to strafe and N to fire
+	BUTTON_BETTY_RIGHT = 1 << 1,
+	BUTTON_BETTY_UP = 1 << 2,
+	BUTTON_BETTY_DOWN = 1 << 3,
+	BUTTON_BETTY_STRAFE = 1 << 4,
+	BUTTON_BETTY_FIRE = 1 << 5,
+	BUTTON_GEORGE_LEFT = 1 << 6,	// WASD, G to strafe and F to fire
+	BUTTON_GEORGE_RIGHT = 1 << 7,
+	BUTTON_GEORGE_UP = 1 << 8,
+	BUTTON_GEORGE_DOWN = 1 << 9,
+	BUTTON_GEORGE_STRAFE = 1 << 10,
+	BUTTON_GEORGE_FIRE = 1 << 11
+};
+#define NUM_BUTTONS 12
+
 GLuint asciiSpriteSheetTexture;
 GLuint bettySpriteSheet, georgeSpriteSheet;
 GLuint enemySpaceshipSpriteSheet;
@@ -54,111 +112,21 @@ GLuint spaceInvaderSpriteSheet;
 GLuint greenButtonSpriteSheet;
 
 bool done = false;              // Game loop
-float lastFrameTicks = 0.0f;    // Set time to an initial value of 0
 float accumulator = 0.0f;
-
-GLuint LoadTexture(const char *filePath) {
-	int w, h, comp;
-	unsigned char* image = stbi_load(filePath, &w, &h, &comp, STBI_rgb_alpha);
-
-	if (image == NULL) {
-		std::cout << "Unable to load image. Make sure the path is correct\n";
-		assert(false);
-	}
-
-	GLuint retTexture;
-	glGenTextures(1, &retTexture);
-	glBindTexture(GL_TEXTURE_2D, retTexture);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	stbi_image_free(image);
-	return retTexture;
-}
-
-class SheetSprite {
-public:
-	SheetSprite() {};
-	SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size);
-	void Draw(ShaderProgram &program);
-
-	float u;
-	float v;
-	float width;
-	float height;
-	float size;
-	unsigned int textureID;
-};
-
-SheetSprite::SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size) {
-	this->textureID = textureID;
-	this->u = u;
-	this->v = v;
-	this->width = width;
-	this->height = height;
-	this->size = size;
-}
-
-void SheetSprite::Draw(ShaderProgram &program) {
-	glBindTexture(GL_TEXTURE_2D, textureID);
-
-	float aspectRatio = width / height;
-	float vertices[] = {
-		-0.5f * size * aspectRatio, -0.5f * size,
-		 0.5f * size * aspectRatio,  0.5f * size,
-		-0.5f * size * aspectRatio,  0.5f * size,
-		 0.5f * size * aspectRatio,  0.5f * size,
-		-0.5f * size * aspectRatio, -0.5f * size,
-		 0.5f * size * aspectRatio, -0.5f * size
-	};
-	float texCoords[] = {
-		u, v + height,
-		u + width, v,
-		u, v,
-		u + width, v,
-		u, v + height,
-		u + width, v + height
-	};
-
-	glUseProgram(program.programID);
-
-	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertices);
-	glEnableVertexAttribArray(program.positionAttribute);
-
-	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoords);
-	glEnableVertexAttribArray(program.texCoordAttribute);
-
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glDisableVertexAttribArray(program.positionAttribute);
-	glDisableVertexAttribArray(program.texCoordAttribute);
-}
+float fixedTimestep = FIXED_TIMESTEP;	// Can be lowered with the TICK_RATE environment variable
 
 class Entity {
 public:
-	int playerScore;
-
 	void Update(float elapsed);
 	void Render(ShaderProgram &program);
 	bool CollidesWith(Entity &otherEntity);
 
 	SheetSprite sprite;
-	Direction faceDirection;
-	Direction moveDirection;
 	EntityType entityType;
 
 	glm::vec3 position;
 	glm::vec3 size;
 	glm::vec3 velocity;
-	glm::vec3 acceleration = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	float moveCounter;
-	bool dead = false;
-	bool canShoot;
-	float shootCounter;
-	int bulletIndex;
-	void ShootBullet(Entity &bullet);
 
 	bool collidedTop;
 	bool collidedBottom;
@@ -166,8 +134,8 @@ public:
 	bool collidedRight;
 
 private:
-	void Entity::ResolveCollisionX(Entity &otherEntity);
-	void Entity::ResolveCollisionY(Entity &otherEntity);
+	void ResolveCollisionX(Entity &otherEntity);
+	void ResolveCollisionY(Entity &otherEntity);
 };
 
 void Entity::Update(float elapsed) {
@@ -225,22 +193,359 @@ void Entity::ResolveCollisionY(Entity& otherEntity) {
 	}
 }
 
-void Entity::ShootBullet(Entity &bullet) {
-	bullet.position = glm::vec3(this->position.x, this->position.y, 1.0f);
+// Bullets and enemies are stored as parallel arrays (structure of arrays)
+// instead of as Entity objects. Update is a branch-free loop the compiler can vectorize
+// and Overlaps hands the arrays straight to the SIMD OverlapBoxes() kernel.
+// Half extents follow CollidesWith(): sprite width/height multiplied by the size.
+// previousX/previousY hold the position from the start of the last tick for render interpolation.
+struct EntityArrays {
+	vector<float> x;
+	vector<float> y;
+	vector<float> previousX;
+	vector<float> previousY;
+	vector<float> velocityX;
+	vector<float> velocityY;
+	vector<float> halfWidth;
+	vector<float> halfHeight;
+	vector<float> size;
+	vector<int> sprite;		// Index into GameState::sprites
+
+	size_t Count() const { return x.size(); }
+	void Reserve(size_t capacity);
+	void Add(float x, float y, float velocityX, float velocityY, float size, int sprite, const SheetSprite &sheet);
+	void Remove(size_t i);
+	void Clear();
+	void Update(float elapsed);
+	void Update(float elapsed, size_t begin, size_t end);
+	void Overlaps(float x, float y, float halfWidth, float halfHeight, unsigned int *mask) const;
+	void Render(ShaderProgram &program, SheetSprite *sprites, float alpha);
+};
+
+void EntityArrays::Reserve(size_t capacity) {
+	x.reserve(capacity);
+	y.reserve(capacity);
+	previousX.reserve(capacity);
+	previousY.reserve(capacity);
+	velocityX.reserve(capacity);
+	velocityY.reserve(capacity);
+	halfWidth.reserve(capacity);
+	halfHeight.reserve(capacity);
+	size.reserve(capacity);
+	sprite.reserve(capacity);
+}
+
+void EntityArrays::Add(float x, float y, float velocityX, float velocityY, float size, int sprite, const SheetSprite &sheet) {
+	this->x.push_back(x);
+	this->y.push_back(y);
+	this->previousX.push_back(x);
+	this->previousY.push_back(y);
+	this->velocityX.push_back(velocityX);
+	this->velocityY.push_back(velocityY);
+	this->halfWidth.push_back(sheet.width * size);
+	this->halfHeight.push_back(sheet.height * size);
+	this->size.push_back(size);
+	this->sprite.push_back(sprite);
+}
+
+// Order is not preserved: the last element is moved into the hole
+void EntityArrays::Remove(size_t i) {
+	size_t last = Count() - 1;
+	x[i] = x[last];
+	y[i] = y[last];
+	previousX[i] = previousX[last];
+	previousY[i] = previousY[last];
+	velocityX[i] = velocityX[last];
+	velocityY[i] = velocityY[last];
+	halfWidth[i] = halfWidth[last];
+	halfHeight[i] = halfHeight[last];
+	size[i] = size[last];
+	sprite[i] = sprite[last];
+	x.pop_back();
+	y.pop_back();
+	previousX.pop_back();
+	previousY.pop_back();
+	velocityX.pop_back();
+	velocityY.pop_back();
+	halfWidth.pop_back();
+	halfHeight.pop_back();
+	size.pop_back();
+	sprite.pop_back();
+}
+
+void EntityArrays::Clear() {
+	x.clear();
+	y.clear();
+	previousX.clear();
+	previousY.clear();
+	velocityX.clear();
+	velocityY.clear();
+	halfWidth.clear();
+	halfHeight.clear();
+	size.clear();
+	sprite.clear();
+}
+
+void EntityArrays::Update(float elapsed) {
+	Update(elapsed, 0, Count());
+}
+
+// Moves elements [begin, end) so the arrays can be split across jobs
+void EntityArrays::Update(float elapsed, size_t begin, size_t end) {
+	float *__restrict px = x.data();
+	float *__restrict py = y.data();
+	float *__restrict previousPx = previousX.data();
+	float *__restrict previousPy = previousY.data();
+	const float *__restrict vx = velocityX.data();
+	const float *__restrict vy = velocityY.data();
+	for (size_t i = begin; i < end; i++) {
+		previousPx[i] = px[i];
+		previousPy[i] = py[i];
+		px[i] += vx[i] * elapsed;
+		py[i] += vy[i] * elapsed;
+	}
+}
+
+// Sets bit i of mask for every element whose box overlaps the query box
+void EntityArrays::Overlaps(float x, float y, float halfWidth, float halfHeight, unsigned int *mask) const {
+	OverlapBoxes(x, y, halfWidth, halfHeight, this->x.data(), this->y.data(), this->halfWidth.data(), this->halfHeight.data(), Count(), mask);
+}
+
+// alpha is how far the renderer is between the previous and the current tick (0 to 1)
+void EntityArrays::Render(ShaderProgram &program, SheetSprite *sprites, float alpha) {
+	for (size_t i = 0; i < Count(); i++) {
+		float renderX = previousX[i] + (x[i] - previousX[i]) * alpha;
+		float renderY = previousY[i] + (y[i] - previousY[i]) * alpha;
+		glm::mat4 modelMatrix = glm::mat4(1.0f);
+		modelMatrix = glm::translate(modelMatrix, glm::vec3(renderX, renderY, 0.0f));
+		modelMatrix = glm::scale(modelMatrix, glm::vec3(size[i], size[i], 1.0f));
+		program.SetModelMatrix(modelMatrix);
+		sprites[sprite[i]].Draw(program);
+	}
+}
+
+// How an explosion throws out its particles
+struct ParticleEmitter {
+	int count;
+	float minSpeed;
+	float maxSpeed;
+	float minLifetime;	// Seconds
+	float maxLifetime;
+	float startSize;
+	float endSize;
+};
+
+// Explosion particles in a fixed-size ring buffer (structure of arrays). Emitting writes over
+// the oldest slot, so chain kills never allocate and never hold more than the capacity.
+// A slot is alive while age < lifetime. Size and fade follow the age, not the tick count.
+struct ParticlePool {
+	vector<float> x;
+	vector<float> y;
+	vector<float> previousX;
+	vector<float> previousY;
+	vector<float> velocityX;
+	vector<float> velocityY;
+	vector<float> age;
+	vector<float> lifetime;
+	vector<float> startSize;
+	vector<float> endSize;
+	vector<int> sprite;		// Index into GameState::sprites
+
+	size_t next;			// Slot the next particle is written to
+	float lastElapsed;		// Length of the last tick, to interpolate ages between ticks
+
+	size_t Count() const { return x.size(); }
+	size_t LiveCount() const;
+	void Setup(size_t capacity);
+	void Clear();
+	void Emit(const ParticleEmitter &emitter, float x, float y, int sprite, Random &random);
+	void Update(float elapsed);
+	void Render(ShaderProgram &program, GLuint fadeAttribute, SheetSprite *sprites, float alpha);
+};
+
+void ParticlePool::Setup(size_t capacity) {
+	x.assign(capacity, 0.0f);
+	y.assign(capacity, 0.0f);
+	previousX.assign(capacity, 0.0f);
+	previousY.assign(capacity, 0.0f);
+	velocityX.assign(capacity, 0.0f);
+	velocityY.assign(capacity, 0.0f);
+	age.assign(capacity, 0.0f);
+	lifetime.assign(capacity, 0.0f);
+	startSize.assign(capacity, 0.0f);
+	endSize.assign(capacity, 0.0f);
+	sprite.assign(capacity, 0);
+	next = 0;
+	lastElapsed = 0.0f;
+}
+
+size_t ParticlePool::LiveCount() const {
+	size_t live = 0;
+	for (size_t i = 0; i < Count(); i++) {
+		live += age[i] < lifetime[i];
+	}
+	return live;
+}
+
+void ParticlePool::Clear() {
+	std::fill(age.begin(), age.end(), 0.0f);
+	std::fill(lifetime.begin(), lifetime.end(), 0.0f);
+	next = 0;
+}
+
+// Throws emitter.count particles out of (x, y) in random directions
+void ParticlePool::Emit(const ParticleEmitter &emitter, float x, float y, int sprite, Random &random) {
+	for (int n = 0; n < emitter.count; n++) {
+		size_t i = next;
+		next = (next + 1) % Count();
+
+		float angle = random.NextFloat(0.0f, 6.2831853f);
+		float speed = random.NextFloat(emitter.minSpeed, emitter.maxSpeed);
+		this->x[i] = x;
+		this->y[i] = y;
+		this->previousX[i] = x;
+		this->previousY[i] = y;
+		this->velocityX[i] = cosf(angle) * speed;
+		this->velocityY[i] = sinf(angle) * speed;
+		this->age[i] = 0.0f;
+		this->lifetime[i] = random.NextFloat(emitter.minLifetime, emitter.maxLifetime);
+		this->startSize[i] = emitter.startSize;
+		this->endSize[i] = emitter.endSize;
+		this->sprite[i] = sprite;
+	}
+}
+
+// Every slot is moved and aged, dead or alive, so the loop has no branches
+void ParticlePool::Update(float elapsed) {
+	float *__restrict px = x.data();
+	float *__restrict py = y.data();
+	float *__restrict previousPx = previousX.data();
+	float *__restrict previousPy = previousY.data();
+	float *__restrict particleAge = age.data();
+	const float *__restrict vx = velocityX.data();
+	const float *__restrict vy = velocityY.data();
+	for (size_t i = 0; i < Count(); i++) {
+		previousPx[i] = px[i];
+		previousPy[i] = py[i];
+		px[i] += vx[i] * elapsed;
+		py[i] += vy[i] * elapsed;
+		particleAge[i] += elapsed;
+	}
+	lastElapsed = elapsed;
+}
+
+// Packs every live particle into one vertex array and draws them with a single call.
+// All particle sprites are on one sheet, so the batch binds a single texture.
+// The vertex arrays come from the frame arena, 6 vertices per slot.
+void ParticlePool::Render(ShaderProgram &program, GLuint fadeAttribute, SheetSprite *sprites, float alpha) {
+	float *vertices = frameArena.AllocateArray<float>(Count() * 12);
+	float *texCoords = frameArena.AllocateArray<float>(Count() * 12);
+	float *fades = frameArena.AllocateArray<float>(Count() * 6);
+	size_t count = 0;
+	GLuint texture = 0;
+	for (size_t i = 0; i < Count(); i++) {
+		if (!(age[i] < lifetime[i])) {
+			continue;
+		}
+		float renderAge = std::max(age[i] - (1.0f - alpha) * lastElapsed, 0.0f);
+		float t = renderAge / lifetime[i];
+		float size = startSize[i] + (endSize[i] - startSize[i]) * t;
+		float renderX = previousX[i] + (x[i] - previousX[i]) * alpha;
+		float renderY = previousY[i] + (y[i] - previousY[i]) * alpha;
+
+		const SheetSprite &sheet = sprites[sprite[i]];
+		texture = sheet.textureID;
+		float halfWidth = 0.5f * size * sheet.width / sheet.height;
+		float halfHeight = 0.5f * size;
+
+		// Same corners as SheetSprite::Draw()
+		float *v = &vertices[count * 12];
+		v[0] = renderX - halfWidth; v[1] = renderY - halfHeight;
+		v[2] = renderX + halfWidth; v[3] = renderY + halfHeight;
+		v[4] = renderX - halfWidth; v[5] = renderY + halfHeight;
+		v[6] = renderX + halfWidth; v[7] = renderY + halfHeight;
+		v[8] = renderX - halfWidth; v[9] = renderY - halfHeight;
+		v[10] = renderX + halfWidth; v[11] = renderY - halfHeight;
+
+		float *uv = &texCoords[count * 12];
+		uv[0] = sheet.u; uv[1] = sheet.v + sheet.height;
+		uv[2] = sheet.u + sheet.width; uv[3] = sheet.v;
+		uv[4] = sheet.u; uv[5] = sheet.v;
+		uv[6] = sheet.u + sheet.width; uv[7] = sheet.v;
+		uv[8] = sheet.u; uv[9] = sheet.v + sheet.height;
+		uv[10] = sheet.u + sheet.width; uv[11] = sheet.v + sheet.height;
+
+		std::fill(&fades[count * 6], &fades[count * 6] + 6, 1.0f - t);
+		count++;
+	}
+	if (count == 0) {
+		return;
+	}
+
+	program.SetModelMatrix(glm::mat4(1.0f));
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertices);
+	glEnableVertexAttribArray(program.positionAttribute);
+	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoords);
+	glEnableVertexAttribArray(program.texCoordAttribute);
+	glVertexAttribPointer(fadeAttribute, 1, GL_FLOAT, false, 0, fades);
+	glEnableVertexAttribArray(fadeAttribute);
+
+	glDrawArrays(GL_TRIANGLES, 0, 6 * (int)count);
+
+	glDisableVertexAttribArray(program.positionAttribute);
+	glDisableVertexAttribArray(program.texCoordAttribute);
+	glDisableVertexAttribArray(fadeAttribute);
+}
+
+// Player-only state is kept out of Entity so buttons don't carry it
+class Player : public Entity {
+public:
+	void ShootBullet(EntityArrays &bullets, int sprite, const SheetSprite &sheet);
+	void Render(ShaderProgram &program, float alpha);
+
+	glm::vec3 previousPosition;	// Position at the start of the last tick
+
+	Direction faceDirection;
+	Direction moveDirection;
+	float moveCounter;
+	bool dead = false;
+
+	int playerScore;
+	bool canShoot;
+	float shootCounter;
+};
+
+// Adds a bullet to the shooter's active list unless MAX_BULLETS are already flying
+void Player::ShootBullet(EntityArrays &bullets, int sprite, const SheetSprite &sheet) {
+	if (bullets.Count() >= MAX_BULLETS) {
+		return;
+	}
+	float velocityX = 0.0f;
+	float velocityY = 0.0f;
 	switch (this->faceDirection) {
 	case UP:
-		bullet.velocity = glm::vec3(0.0f, 1.3f, 0.0f);
+		velocityY = 1.3f;
 		break;
 	case DOWN:
-		bullet.velocity = glm::vec3(0.0f, -1.3f, 0.0f);
+		velocityY = -1.3f;
 		break;
 	case LEFT:
-		bullet.velocity = glm::vec3(-1.3f, 0.0f, 0.0f);
+		velocityX = -1.3f;
 		break;
 	case RIGHT:
-		bullet.velocity = glm::vec3(1.3f, 0.0f, 0.0f);
+		velocityX = 1.3f;
 		break;
 	}
+	bullets.Add(this->position.x, this->position.y, velocityX, velocityY, 0.05f, sprite, sheet);
+}
+
+void Player::Render(ShaderProgram &program, float alpha) {
+	glm::mat4 modelMatrix = glm::mat4(1.0f);
+	modelMatrix = glm::translate(modelMatrix, previousPosition + (position - previousPosition) * alpha);
+	modelMatrix = glm::scale(modelMatrix, size);
+	program.SetModelMatrix(modelMatrix);
+	sprite.Draw(program);
 }
 
 struct MainMenuState {
@@ -251,23 +556,65 @@ struct MainMenuState {
 
 	GLuint backgroundTexture;
 	void Setup();
+	void Enter();
 	void ProcessEvents();
 	void Render();
 };
 
+enum SpriteId {
+	SPRITE_BULLET_BETTY,
+	SPRITE_BULLET_GEORGE,
+	SPRITE_PARTICLE_BETTY,
+	SPRITE_PARTICLE_GEORGE,
+	SPRITE_ENEMY_PINK,
+	SPRITE_ENEMY_BLUE,
+	SPRITE_ENEMY_GREEN,
+	SPRITE_ENEMY_YELLOW,
+	SPRITE_ENEMY_BEIGE,
+	NUM_SPRITES
+};
+#define NUM_ENEMY_SPRITES 5
+
+// Burst thrown out where a bullet hits an enemy
+const ParticleEmitter BOOM_EMITTER = { 24, 0.1f, 0.6f, 0.4f, 1.0f, 0.06f, 0.3f };
+
+// What one bullet hit during a tick, found by a job and applied after all jobs finish
+struct BulletHit {
+	int bullet;
+	int enemy;			// -1 if no enemy was hit
+	float enemyTime;	// Time of impact within the tick
+	float targetTime;	// -1 if the other player was not hit
+};
+
 struct GameState {
-	Entity Betty;
-	Entity George;
-	vector<Entity> BulletsBetty;
-	vector<Entity> BulletsGeorge;
-	vector<Entity> particles;
-	vector<Entity> enemies;
+	Player Betty;
+	Player George;
+	EntityArrays BulletsBetty;
+	EntityArrays BulletsGeorge;
+	ParticlePool particles;
+	EntityArrays enemies;
+	vector<vector<BulletHit>> bulletHits;	// One buffer per job worker, filled on the workers
+
+	// Bullets in flight, summed over every tick of the session for the stats printed at exit
+	size_t bulletTicks;
+	size_t bulletSum;
+	size_t bulletPeak;
+
+	unsigned long long seed;	// Seeds every random stream of this game, saved in replays
+	Random spawnRandom;		// Enemy size, position, side and color
+	Random particleRandom;	// Explosion directions, speeds and lifetimes
+	unsigned int buttons;	// Buttons held during the current tick
+
+	bool Held(unsigned int button) {
+		return (this->buttons & button) != 0;
+	}
 
 	int numberOfEnemies;
 	float spawnRate;
 	float enemySpeed;
 
 	GLuint backgroundTexture;
+	bool ready;		// Reset() has run since the last game started, so it can start straight away
 
 	SheetSprite skull;
 	vector<SheetSprite> PlayerOneLeft;
@@ -280,24 +627,21 @@ struct GameState {
 	vector<SheetSprite> PlayerTwoUp;
 	vector<SheetSprite> PlayerTwoDown;
 
-	SheetSprite bulletBetty;
-	SheetSprite bulletGeorge;
-	SheetSprite particleBetty;
-	SheetSprite particleGeorge;
-
-	SheetSprite pinkEnemySpaceship;
-	SheetSprite blueEnemySpaceship;
-	SheetSprite greenEnemySpaceship;
-	SheetSprite yellowEnemySpaceship;
-	SheetSprite beigeEnemySpaceship;
+	// Bullet, particle and enemy sprites, indexed by SpriteId
+	SheetSprite sprites[NUM_SPRITES];
 
 	void Setup();
+	void Reset();
+	void SpawnEnemy();
 	void SpawnEnemies();
+	void SkipToWave(int wave);
+	void FillTo(size_t enemyCount, size_t bulletCount, size_t particleCount);
 	void LoadSprites();
-	void CreateBoom(SheetSprite &sheet, float x, float y);
-	void ProcessEvents();
+	void CreateBoom(int sprite, float x, float y);
+	void UpdateBullets(EntityArrays &bullets, Player &shooter, Player &target, int particleSprite, float elapsed);
+	void ProcessInput();
 	void Update(float elapsed);
-	void Render();
+	void Render(float alpha);
 };
 
 struct GameOverState {
@@ -307,8 +651,13 @@ struct GameOverState {
 
 	SheetSprite greenButton;
 
+	// Scores of the game that just ended, so the level can be reset while they are shown
+	int bettyScore;
+	int georgeScore;
+
 	GLuint backgroundTexture;
 	void Setup();
+	void Enter();
 	void ProcessEvents();
 	void Render();
 };
@@ -318,45 +667,10 @@ MainMenuState mainMenuState;
 GameState gameState;
 GameOverState gameOverState;
 
-void DrawText(ShaderProgram &program, int fontTexture, std::string text, float size, float spacing) {
-	float character_size = 1.0 / 16.0f;
-	std::vector<float> vertexData;
-	std::vector<float> texCoordData;
-	for (size_t i = 0; i < text.size(); i++) {
-		int spriteIndex = (int)text[i];
-		float texture_x = (float)(spriteIndex % 16) / 16.0f;
-		float texture_y = (float)(spriteIndex / 16) / 16.0f;
-		vertexData.insert(vertexData.end(), {
-			((size + spacing) * i) + (-0.5f * size),  0.5f * size,
-			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
-			((size + spacing) * i) + (0.5f * size),  0.5f * size,
-			((size + spacing) * i) + (0.5f * size), -0.5f * size,
-			((size + spacing) * i) + (0.5f * size),  0.5f * size,
-			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
-			});
-		texCoordData.insert(texCoordData.end(), {
-			texture_x, texture_y,
-			texture_x, texture_y + character_size,
-			texture_x + character_size, texture_y,
-			texture_x + character_size, texture_y + character_size,
-			texture_x + character_size, texture_y,
-			texture_x, texture_y + character_size,
-			});
-	}
-	glBindTexture(GL_TEXTURE_2D, fontTexture);
-
-	// draw this data (use the .data() method of std::vector to get pointer to data)
-	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertexData.data());
-	glEnableVertexAttribArray(program.positionAttribute);
-
-	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoordData.data());
-	glEnableVertexAttribArray(program.texCoordAttribute);
-
-	// draw this yourself, use text.size() * 6 or vertexData.size()/2 to get number of vertices
-	glDrawArrays(GL_TRIANGLES, 0, 6 * (int)text.size());
-	glDisableVertexAttribArray(program.positionAttribute);
-	glDisableVertexAttribArray(program.texCoordAttribute);
-}
+// Time spent switching screens in EnterMode(), printed at exit
+int transitions = 0;
+float transitionSumMs = 0.0f;
+float transitionMaxMs = 0.0f;
 
 void setBackgroundTexture(GLuint backgroundTexture) {
 	glUseProgram(texturedProgram.programID);
@@ -379,12 +693,10 @@ void setBackgroundTexture(GLuint backgroundTexture) {
 	glDisableVertexAttribArray(texturedProgram.texCoordAttribute);
 }
 
+// Loads the menu once at startup, Enter() shows it
 void MainMenuState::Setup() {
+	TRACE_SCOPE("MainMenuState::Setup");
 	backgroundTexture = LoadTexture("assets/main_menu_background.jpg");
-	setBackgroundTexture(backgroundTexture);
-
-	// Play background music
-	Mix_PlayMusic(backgroundMusic, 1);
 
 	greenButton = SheetSprite(greenButtonSpriteSheet, 0.0f / 512.0f, 0.0f / 256.0f, 190.0f / 512.0f, 49.0f / 256.0f, 1.0f);
 
@@ -399,7 +711,13 @@ void MainMenuState::Setup() {
 	quitButton.size = glm::vec3(0.5f, 0.25f, 1.0f);
 }
 
+void MainMenuState::Enter() {
+	// Play background music
+	Mix_PlayMusic(backgroundMusic, 1);
+}
+
 void GameState::LoadSprites() {
+	TRACE_SCOPE("GameState::LoadSprites");
 	// Load Betty sprites
 	for (int i = 0; i < 16; i++) {
 		int row = i / 4;
@@ -447,81 +765,127 @@ void GameState::LoadSprites() {
 
 	// Load Player Bullets sprites
 	GLuint bulletBettyTexture = LoadTexture("assets/BulletBetty.png");
-	bulletBetty = SheetSprite(bulletBettyTexture, 0.0f / 24.0f, 0.0f / 24.0f, 24.0f / 24.0f, 24.0f / 24.0f, 1.0f);
+	sprites[SPRITE_BULLET_BETTY] = SheetSprite(bulletBettyTexture, 0.0f / 24.0f, 0.0f / 24.0f, 24.0f / 24.0f, 24.0f / 24.0f, 1.0f);
 	GLuint bulletGeorgeTexture = LoadTexture("assets/BulletGeorge.png");
-	bulletGeorge = SheetSprite(bulletGeorgeTexture, 0.0f / 24.0f, 0.0f / 24.0f, 24.0f / 24.0f, 24.0f / 24.0f, 1.0f);
+	sprites[SPRITE_BULLET_GEORGE] = SheetSprite(bulletGeorgeTexture, 0.0f / 24.0f, 0.0f / 24.0f, 24.0f / 24.0f, 24.0f / 24.0f, 1.0f);
 	
 	// Load Skull sprite
 	GLuint skullTexture = LoadTexture("assets/skull.png");
 	skull = SheetSprite(skullTexture, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
 
 	// Load particle sprites
-	particleBetty = SheetSprite(spaceInvaderSpriteSheet, 602.0f / 1024.0f, 600.0f / 1024.0f, 48.0f / 1024.0f, 46.0f / 1024.0f, 1.0f);
-	particleGeorge = SheetSprite(spaceInvaderSpriteSheet, 434.0f / 1024.0f, 325.0f / 1024.0f, 48.0f / 1024.0f, 46.0f / 1024.0f, 1.0f);
+	sprites[SPRITE_PARTICLE_BETTY] = SheetSprite(spaceInvaderSpriteSheet, 602.0f / 1024.0f, 600.0f / 1024.0f, 48.0f / 1024.0f, 46.0f / 1024.0f, 1.0f);
+	sprites[SPRITE_PARTICLE_GEORGE] = SheetSprite(spaceInvaderSpriteSheet, 434.0f / 1024.0f, 325.0f / 1024.0f, 48.0f / 1024.0f, 46.0f / 1024.0f, 1.0f);
 	
 	// Load enemy spaceship sprites
-	pinkEnemySpaceship = SheetSprite(enemySpaceshipSpriteSheet, 0.0f / 512.0f, 294.0f / 512.0f, 124.0f / 512.0f, 127.0f / 512.0f, 1.0f);
-	blueEnemySpaceship = SheetSprite(enemySpaceshipSpriteSheet, 248.0f / 512.0f, 0.0f / 512.0f, 124.0f / 512.0f, 145.0f / 512.0f, 1.0f);
-	greenEnemySpaceship = SheetSprite(enemySpaceshipSpriteSheet, 124.0f / 512.0f, 144.0f / 512.0f, 124.0f / 512.0f, 123.0f / 512.0f, 1.0f);
-	yellowEnemySpaceship = SheetSprite(enemySpaceshipSpriteSheet, 0.0f / 512.0f, 0.0f / 512.0f, 124.0f / 512.0f, 108.0f / 512.0f, 1.0f);
-	beigeEnemySpaceship = SheetSprite(enemySpaceshipSpriteSheet, 372.0f / 512.0f, 0.0f / 512.0f, 124.0f / 512.0f, 122.0f / 512.0f, 1.0f);
+	sprites[SPRITE_ENEMY_PINK] = SheetSprite(enemySpaceshipSpriteSheet, 0.0f / 512.0f, 294.0f / 512.0f, 124.0f / 512.0f, 127.0f / 512.0f, 1.0f);
+	sprites[SPRITE_ENEMY_BLUE] = SheetSprite(enemySpaceshipSpriteSheet, 248.0f / 512.0f, 0.0f / 512.0f, 124.0f / 512.0f, 145.0f / 512.0f, 1.0f);
+	sprites[SPRITE_ENEMY_GREEN] = SheetSprite(enemySpaceshipSpriteSheet, 124.0f / 512.0f, 144.0f / 512.0f, 124.0f / 512.0f, 123.0f / 512.0f, 1.0f);
+	sprites[SPRITE_ENEMY_YELLOW] = SheetSprite(enemySpaceshipSpriteSheet, 0.0f / 512.0f, 0.0f / 512.0f, 124.0f / 512.0f, 108.0f / 512.0f, 1.0f);
+	sprites[SPRITE_ENEMY_BEIGE] = SheetSprite(enemySpaceshipSpriteSheet, 372.0f / 512.0f, 0.0f / 512.0f, 124.0f / 512.0f, 122.0f / 512.0f, 1.0f);
+}
+
+void GameState::SpawnEnemy() {
+	float enemySize = this->spawnRandom.NextFloat(0.2f, 0.32f);
+
+	// Randomly pick the starting position of the enemy
+	float x = this->spawnRandom.NextFloat(0.0f, 2.0f);
+	float y, velocityY;
+	bool topOrBottom = this->spawnRandom.NextBool();
+	if (topOrBottom) {
+		y = 2.0f;
+		velocityY = 0 - this->enemySpeed;
+	} else {
+		y = -2.0f;
+		velocityY = this->enemySpeed;
+	}
+
+	// Randomly pick the color of the enemy
+	int enemySprite = SPRITE_ENEMY_PINK + this->spawnRandom.NextInt(NUM_ENEMY_SPRITES);
+
+	this->enemies.Add(-1.0f + x, y, 0.0f, velocityY, enemySize, enemySprite, this->sprites[enemySprite]);
 }
 
 void GameState::SpawnEnemies() {
 	for (int i = 0; i < this->numberOfEnemies; i++) {
-		Entity enemy;
-		float enemySize = 0.2 + static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / 0.12f));;
-		enemy.size = glm::vec3(enemySize, enemySize, 1.0f);
-		enemy.velocity = glm::vec3(0.0f, -0.1f, 0.0f);
-
-		// Randomly pick the starting position of the enemy
-		float x = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / 2.0f));	// Get a random float between 0.0 and 2.0
-		enemy.position.x = -1.0f + x;
-		enemy.position.z = 0.0f;
-		int topOrBottom = rand() % 2;
-		if (topOrBottom) {
-			enemy.position = glm::vec3(-1.0f + x, 2.0f, 0.0f);
-			enemy.velocity = glm::vec3(0.0f, 0 - this->enemySpeed, 0.0f);
-		} else {
-			enemy.position = glm::vec3(-1.0f + x, -2.0f, 0.0f);
-			enemy.velocity = glm::vec3(0.0f, this->enemySpeed, 0.0f);
-		}
+		this->SpawnEnemy();
+	}
+}
 
-		// Randomly pick the color of the enemy
-		int enemySpriteIndex = rand() % 5;
-		switch (enemySpriteIndex) {
-		case 0: enemy.sprite = this->pinkEnemySpaceship; break;
-		case 1: enemy.sprite = this->blueEnemySpaceship; break;
-		case 2: enemy.sprite = this->greenEnemySpaceship; break;
-		case 3: enemy.sprite = this->yellowEnemySpaceship; break;
-		case 4: enemy.sprite = this->beigeEnemySpaceship; break;
-		}
+// Spawns wave (1 is the first) as if the game had been running until it came
+void GameState::SkipToWave(int wave) {
+	this->numberOfEnemies = 4 + wave;
+	this->enemySpeed = 0.1f + 0.05f * (wave - 1);
+	this->enemies.Clear();
+	this->SpawnEnemies();
+}
 
-		this->enemies.push_back(enemy);
+// Tops the level up to a stress test step's load. Enemies come in from the edges as usual,
+// bullets fly from the players in random directions and explosions go off anywhere.
+void GameState::FillTo(size_t enemyCount, size_t bulletCount, size_t particleCount) {
+	while (this->enemies.Count() < enemyCount) {
+		this->SpawnEnemy();
+	}
+	while (this->BulletsBetty.Count() + this->BulletsGeorge.Count() < bulletCount) {
+		bool betty = this->BulletsBetty.Count() <= this->BulletsGeorge.Count();
+		Player &shooter = betty ? this->Betty : this->George;
+		int sprite = betty ? SPRITE_BULLET_BETTY : SPRITE_BULLET_GEORGE;
+		float angle = this->particleRandom.NextFloat(0.0f, 6.2831853f);
+		(betty ? this->BulletsBetty : this->BulletsGeorge).Add(shooter.position.x, shooter.position.y,
+			1.3f * cosf(angle), 1.3f * sinf(angle), 0.05f, sprite, this->sprites[sprite]);
+	}
+	if (this->particles.Count() < particleCount) {
+		this->particles.Setup(particleCount);
+	}
+	for (size_t live = this->particles.LiveCount(); live < particleCount; live += BOOM_EMITTER.count) {
+		float x = this->particleRandom.NextFloat(-1.7f, 1.7f);
+		float y = this->particleRandom.NextFloat(-1.7f, 1.7f);
+		this->CreateBoom(this->particleRandom.NextBool() ? SPRITE_PARTICLE_BETTY : SPRITE_PARTICLE_GEORGE, x, y);
 	}
 }
 
-void GameState::CreateBoom(SheetSprite &sheet, float x, float y) {
-	Entity particle;
-	particle.sprite = sheet;
-	particle.entityType = PARTICLE;
-	particle.position = glm::vec3(x, y, 0.0f);
-	particle.size = glm::vec3(0.0f, 0.0f, 0.0f);
-	particle.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
-	this->particles.push_back(particle);
+void GameState::CreateBoom(int sprite, float x, float y) {
+	this->particles.Emit(BOOM_EMITTER, x, y, sprite, this->particleRandom);
 }
 
+// Loads the level's textures and sprites and reserves its pools, once at startup.
+// Reset() starts each game from there.
 void GameState::Setup() {
+	TRACE_SCOPE("GameState::Setup");
 	this->backgroundTexture = LoadTexture("assets/game_background.png");
 	this->LoadSprites();
 
+	// Only bullets in flight are kept, so a tick without shooting has nothing to update
+	this->BulletsBetty.Reserve(MAX_BULLETS);
+	this->BulletsGeorge.Reserve(MAX_BULLETS);
+
+	// So are the enemies and the per-worker hit buffers (a bullet makes at most one hit), so a
+	// tick allocates nothing until a wave grows past ENEMY_RESERVE. The other collision
+	// scratch buffers come from the frame arena.
+	this->enemies.Reserve(ENEMY_RESERVE);
+	this->bulletHits.resize(jobSystem.WorkerCount());
+	for (size_t w = 0; w < this->bulletHits.size(); w++) {
+		this->bulletHits[w].reserve(MAX_BULLETS);
+	}
+	this->particles.Setup(MAX_PARTICLES);
+	this->ready = false;
+}
+
+// Puts the players, pools and random streams back to the start of a game. Everything is
+// reinitialised in place, so it costs about as much as spawning the first wave.
+void GameState::Reset() {
+	TRACE_SCOPE("GameState::Reset");
 	this->Betty.sprite = this->PlayerOneDown.at(0);
 	this->Betty.faceDirection = DOWN;
 	this->Betty.moveDirection = DOWN;
 	this->Betty.entityType = PLAYER;
 	this->Betty.playerScore = 0;
 	this->Betty.dead = false;
+	this->Betty.moveCounter = 0.0f;
+	this->Betty.canShoot = false;
+	this->Betty.shootCounter = 0.0f;
 	this->Betty.position = glm::vec3(-0.2f, 0.0f, 0.0f);
+	this->Betty.previousPosition = this->Betty.position;
 	this->Betty.size = glm::vec3(0.25f, 0.25f, 1.0f);
 	this->Betty.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
 
@@ -531,42 +895,48 @@ void GameState::Setup() {
 	this->George.entityType = PLAYER;
 	this->George.playerScore = 0;
 	this->George.dead = false;
+	this->George.moveCounter = 0.0f;
+	this->George.canShoot = false;
+	this->George.shootCounter = 0.0f;
 	this->George.position = glm::vec3(0.2f, 0.0f, 0.0f);
+	this->George.previousPosition = this->George.position;
 	this->George.size = glm::vec3(0.25f, 0.25f, 1.0f);
 	this->George.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
 
-	for (int i = 0; i < MAX_BULLETS; i++) {
-		Entity bullet;
-		bullet.sprite = this->bulletBetty;
-		bullet.entityType = BULLET;
-		bullet.position = glm::vec3(-1000.0f, 0.0f, 0.0f);
-		bullet.size = glm::vec3(0.05f, 0.05f, 1.0f);
-		bullet.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
-		this->BulletsBetty.push_back(bullet);
-	}
+	this->BulletsBetty.Clear();
+	this->BulletsGeorge.Clear();
+	this->enemies.Clear();
 
-	for (int i = 0; i < MAX_BULLETS; i++) {
-		Entity bullet;
-		bullet.sprite = this->bulletGeorge;
-		bullet.entityType = BULLET;
-		bullet.position = glm::vec3(1000.0f, 0.0f, 0.0f);
-		bullet.size = glm::vec3(0.05f, 0.05f, 1.0f);
-		bullet.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
-		this->BulletsGeorge.push_back(bullet);
+	// A replay brings its own seed, otherwise draw one from the session
+	if (playingReplay) {
+		this->seed = replay.seed;
+	}
+	else {
+		this->seed = (unsigned long long)sessionRandom.Next() << 32;
+		this->seed |= sessionRandom.Next();
+	}
+	Random gameRandom(this->seed);
+	if (recordPath != NULL) {
+		replay.StartRecording(this->seed, fixedTimestep);
 	}
 
 	// Initialize enemy attributes
+	this->spawnRandom = gameRandom.Fork();
+	this->particleRandom = gameRandom.Fork();
+	this->particles.Setup(MAX_PARTICLES);	// Keeps the capacity, a stress test may have grown it
 	this->spawnRate = 0.0f;
 	this->numberOfEnemies = 5;
 	this->enemySpeed = 0.1f;
 	this->SpawnEnemies();
+	this->ready = true;
 }
 
+// Loads the game over screen once at startup, Enter() shows it
 void GameOverState::Setup() {
-	Mix_PauseMusic();
-
+	TRACE_SCOPE("GameOverState::Setup");
 	backgroundTexture = LoadTexture("assets/main_menu_background.jpg");
-	setBackgroundTexture(backgroundTexture);
+	bettyScore = 0;
+	georgeScore = 0;
 
 	greenButton = SheetSprite(greenButtonSpriteSheet, 0.0f / 512.0f, 0.0f / 256.0f, 190.0f / 512.0f, 49.0f / 256.0f, 1.0f);
 
@@ -586,9 +956,51 @@ void GameOverState::Setup() {
 	quitButton.size = glm::vec3(0.5f, 0.25f, 1.0f);
 }
 
+void GameOverState::Enter() {
+	Mix_PauseMusic();
+	bettyScore = gameState.Betty.playerScore;
+	georgeScore = gameState.George.playerScore;
+}
+
+// Switches to the next screen. Every screen was loaded at startup, so this only resets the
+// one being entered, and the level is normally reset ahead of time (see Update()), which
+// leaves starting a game nothing to do. Each switch is timed and the slowest is reported at exit.
+void EnterMode(GameMode next) {
+	TRACE_SCOPE("EnterMode");
+	Uint64 start = SDL_GetPerformanceCounter();
+	switch (next) {
+	case MAIN_MENU:
+		mainMenuState.Enter();
+		break;
+	case GAME_LEVEL:
+		// The game over screen paused the music, so playing again starts it over
+		if (mode == GAME_OVER) {
+			Mix_PlayMusic(backgroundMusic, 1);
+		}
+		if (!gameState.ready) {
+			gameState.Reset();
+		}
+		gameState.ready = false;
+		break;
+	case GAME_OVER:
+		gameOverState.Enter();
+		break;
+	}
+	mode = next;
+	float ms = (SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+	transitions++;
+	transitionSumMs += ms;
+	transitionMaxMs = std::max(transitionMaxMs, ms);
+}
+
 void Setup() {
+	TRACE_SCOPE("Setup");
 	SDL_Init(SDL_INIT_VIDEO);
-	displayWindow = SDL_CreateWindow("Alien Invasion", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 640, 640, SDL_WINDOW_OPENGL);
+	Uint32 windowFlags = SDL_WINDOW_OPENGL;
+	if (benchmark.active || stress.active) {
+		windowFlags |= SDL_WINDOW_HIDDEN;
+	}
+	displayWindow = SDL_CreateWindow("Alien Invasion", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 640, 640, windowFlags);
 	SDL_GLContext context = SDL_GL_CreateContext(displayWindow);
 	SDL_GL_MakeCurrent(displayWindow, context);
 
@@ -598,9 +1010,42 @@ void Setup() {
 
 	glViewport(0, 0, 640, 640);
 
+	framePacer.Setup(60);
+
+	// Pick the SIMD collision kernel for this CPU
+	InitBoxOverlap();
+
+	// Every game draws its own random streams from the session seed
+	// Benchmarks and stress tests play the same games every run unless SEED says otherwise
+	if ((benchmark.active || stress.active) && SDL_getenv("SEED") == NULL) {
+		sessionRandom.Seed(BENCHMARK_SEED);
+	}
+	else {
+		sessionRandom.Seed(ChooseSeed());
+	}
+
+	// One job worker per hardware thread unless JOB_THREADS says otherwise
+	jobSystem.Setup(0);
+
+	// Count GL calls per render pass when GL_STATS or GL_STATS_CSV is set
+	glStats.Setup();
+	// Time the render passes on the GPU when GPU_TIMER is set, in benchmarks and while the profiler is shown
+	gpuTimer.enabled = benchmark.active;
+	gpuTimer.Setup();
+	gpuTimingAlways = gpuTimer.enabled;
+
+	// A headless server can tick slower than the renderer (e.g. TICK_RATE=20)
+	const char *tickRate = SDL_getenv("TICK_RATE");
+	if (tickRate != NULL && atoi(tickRate) >= TICK_RATE_MIN) {
+		fixedTimestep = 1.0f / atoi(tickRate);
+		std::cout << "Simulating at " << atoi(tickRate) << " ticks per second\n";
+	}
+
 	// Load shader program
 	program.Load("vertex.glsl", "fragment.glsl");
 	texturedProgram.Load("vertex_textured.glsl", "fragment_textured.glsl");
+	particleProgram.Load("vertex_particle.glsl", "fragment_particle.glsl");
+	particleFadeAttribute = glGetAttribLocation(particleProgram.programID, "fade");
 
 	// Load sprite sheets
 	asciiSpriteSheetTexture = LoadTexture("assets/ascii_spritesheet.png");
@@ -631,15 +1076,49 @@ void Setup() {
 	texturedProgram.SetProjectionMatrix(projectionMatrix);
 	texturedProgram.SetViewMatrix(viewMatrix);
 
+	particleProgram.SetProjectionMatrix(projectionMatrix);
+	particleProgram.SetViewMatrix(viewMatrix);
+
 	glUseProgram(texturedProgram.programID);
 
-	keys = SDL_GetKeyboardState(NULL);
 	Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 4096);
 	backgroundMusic = Mix_LoadMUS("assets/background_music.mp3");
 	fireSound = Mix_LoadWAV("assets/shootBulletSound.wav");
 
-	mode = MAIN_MENU; // Render the menu when the user opens the game
+	// Every screen is loaded once here and the first level is reset before anyone asks for it
 	mainMenuState.Setup();
+	gameState.Setup();
+	gameOverState.Setup();
+	gameState.Reset();
+
+	mode = MAIN_MENU; // Render the menu when the user opens the game
+	mainMenuState.Enter();
+
+	// A replay skips the menu and runs at the tick length it was recorded with
+	if (playingReplay) {
+		fixedTimestep = replay.timestep;
+		if (fastReplay) {
+			framePacer.SetTarget(FRAME_PACER_UNCAPPED);
+		}
+		EnterMode(GAME_LEVEL);
+		replayStart = SDL_GetPerformanceCounter();
+	}
+	// A benchmark runs as fast as it can with the GL calls counted
+	else if (benchmark.active) {
+		framePacer.SetTarget(FRAME_PACER_UNCAPPED);
+		glStats.enabled = true;
+		if (benchmarkWave > 0) {
+			EnterMode(GAME_LEVEL);
+			gameState.SkipToWave(benchmarkWave);
+			invulnerable = true;
+		}
+	}
+	// A stress test starts a level straight away and runs it as fast as it can
+	else if (stress.active) {
+		framePacer.SetTarget(FRAME_PACER_UNCAPPED);
+		EnterMode(GAME_LEVEL);
+		invulnerable = true;
+	}
 }
 
 bool clicked(Entity &entity, float cursorX, float cursorY) {
@@ -652,21 +1131,31 @@ bool clicked(Entity &entity, float cursorX, float cursorY) {
 	return false;
 }
 
-void MainMenuState::ProcessEvents() {
-	SDL_Event event;
-	while (SDL_PollEvent(&event)) {
-		if (event.type == SDL_QUIT || event.type == SDL_WINDOWEVENT_CLOSE) {
-			done = true;
-		}
+// Events every screen handles the same way
+void ProcessCommonEvent(const SDL_Event &event) {
+	if (event.type == SDL_QUIT || event.type == SDL_WINDOWEVENT_CLOSE) {
+		done = true;
+	}
+	else if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F3) {
+		showProfiler = !showProfiler;
+		gpuTimer.enabled = showProfiler || gpuTimingAlways;
 	}
-	if (event.type == SDL_MOUSEBUTTONDOWN) {
+	else if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F4) {
+		TraceFlush();	// Nothing to write unless built with TRACING
+	}
+}
+
+// The menus don't tick, they take their input once a frame
+void MainMenuState::ProcessEvents() {
+	inputQueue.BeginTick();
+	int x, y;
+	if (inputQueue.Clicked(&x, &y)) {
 		// Get coordinates of where the user clicked
-		float cursorX = (((float)event.button.x / 640.0f) * 3.554f) - 1.777f;
-		float cursorY = (((float)(640.0f - event.button.y) / 640.0f) * 3.554f) - 1.777f;
+		float cursorX = (((float)x / 640.0f) * 3.554f) - 1.777f;
+		float cursorY = (((float)(640.0f - y) / 640.0f) * 3.554f) - 1.777f;
 
 		if (clicked(playButton, cursorX, cursorY)) {
-			mode = GAME_LEVEL;
-			gameState.Setup();
+			EnterMode(GAME_LEVEL);
 		}
 		else if (clicked(quitButton, cursorX, cursorY)) {
 			done = true;
@@ -674,59 +1163,79 @@ void MainMenuState::ProcessEvents() {
 	}
 }
 
-void GameState::ProcessEvents() {
-	SDL_Event event;
-	while (SDL_PollEvent(&event)) {
-		if (event.type == SDL_QUIT || event.type == SDL_WINDOWEVENT_CLOSE) {
-			done = true;
+// Buttons from the keyboard, read once per fixed tick so movement and walk animation
+// run at the same speed at any frame rate. A key tapped between two ticks still counts
+// for one tick, so a quick shot isn't lost.
+unsigned int ReadButtons() {
+	// Key for each Button, in bit order
+	static const SDL_Scancode BUTTON_KEYS[NUM_BUTTONS] = {
+		SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_M, SDL_SCANCODE_N,
+		SDL_SCANCODE_A, SDL_SCANCODE_D, SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_G, SDL_SCANCODE_F
+	};
+	unsigned int buttons = 0;
+	for (int i = 0; i < NUM_BUTTONS; i++) {
+		if (inputQueue.Down(BUTTON_KEYS[i])) {
+			buttons |= 1u << i;
 		}
 	}
+	return buttons;
+}
 
+// Scripted input for benchmarks: both players fire whenever they can and walk a square,
+// George half a lap behind Betty
+unsigned int BotButtons(int tick) {
+	static const unsigned int BETTY_WALK[4] = { BUTTON_BETTY_LEFT, BUTTON_BETTY_UP, BUTTON_BETTY_RIGHT, BUTTON_BETTY_DOWN };
+	static const unsigned int GEORGE_WALK[4] = { BUTTON_GEORGE_LEFT, BUTTON_GEORGE_UP, BUTTON_GEORGE_RIGHT, BUTTON_GEORGE_DOWN };
+	int step = (tick / BOT_STEP_TICKS) % 4;
+	return BUTTON_BETTY_FIRE | BUTTON_GEORGE_FIRE | BETTY_WALK[step] | GEORGE_WALK[(step + 2) % 4];
+}
+
+void GameState::ProcessInput() {
 	// Player One movement
 	this->Betty.velocity.x = 0.0f;
 	this->Betty.velocity.y = 0.0f;
 	if (!this->Betty.dead) {
-		if (keys[SDL_SCANCODE_LEFT]) {
+		if (this->Held(BUTTON_BETTY_LEFT)) {
 			if (this->Betty.position.x > -1.22f) {
 				this->Betty.velocity.x = -1.0f;
 			}
-			if (!keys[SDL_SCANCODE_M]) {
+			if (!this->Held(BUTTON_BETTY_STRAFE)) {
 				this->Betty.faceDirection = LEFT;
 			}
 		}
-		if (keys[SDL_SCANCODE_RIGHT]) {
+		if (this->Held(BUTTON_BETTY_RIGHT)) {
 			if (this->Betty.position.x < 1.27f) {
 				this->Betty.velocity.x = 1.0f;
 			}
-			if (!keys[SDL_SCANCODE_M]) {
+			if (!this->Held(BUTTON_BETTY_STRAFE)) {
 				this->Betty.faceDirection = RIGHT;
 			}
 		}
-		if (keys[SDL_SCANCODE_UP]) {
+		if (this->Held(BUTTON_BETTY_UP)) {
 			if (this->Betty.position.y + this->Betty.sprite.height / 2 < 1.777f) {
 				this->Betty.velocity.y = 1.0f;
 			}
-			if (!keys[SDL_SCANCODE_M]) {
+			if (!this->Held(BUTTON_BETTY_STRAFE)) {
 				this->Betty.faceDirection = UP;
 			}
 		}
-		if (keys[SDL_SCANCODE_DOWN]) {
+		if (this->Held(BUTTON_BETTY_DOWN)) {
 			if (this->Betty.position.y - this->Betty.sprite.height / 2 > -1.777f) {
 				this->Betty.velocity.y = -1.0f;
 			}
-			if (!keys[SDL_SCANCODE_M]) {
+			if (!this->Held(BUTTON_BETTY_STRAFE)) {
 				this->Betty.faceDirection = DOWN;
 			}
 		}
-		if (!keys[SDL_SCANCODE_LEFT] &&
-			!keys[SDL_SCANCODE_RIGHT] &&
-			!keys[SDL_SCANCODE_UP] &&
-			!keys[SDL_SCANCODE_DOWN]) {
+		if (!this->Held(BUTTON_BETTY_LEFT) &&
+			!this->Held(BUTTON_BETTY_RIGHT) &&
+			!this->Held(BUTTON_BETTY_UP) &&
+			!this->Held(BUTTON_BETTY_DOWN)) {
 			this->Betty.moveCounter = 0.0f;
 		}
 		else {
-			if (this->Betty.moveDirection == this->Betty.faceDirection || keys[SDL_SCANCODE_M]) {
-				this->Betty.moveCounter += 0.005f;
+			if (this->Betty.moveDirection == this->Betty.faceDirection || this->Held(BUTTON_BETTY_STRAFE)) {
+				this->Betty.moveCounter += 0.3f * fixedTimestep;
 			}
 			else {
 				this->Betty.moveCounter = 0.0f;
@@ -749,10 +1258,9 @@ void GameState::ProcessEvents() {
 			break;
 		}
 
-		if (keys[SDL_SCANCODE_N] && this->Betty.canShoot) {
+		if (this->Held(BUTTON_BETTY_FIRE) && this->Betty.canShoot) {
 			this->Betty.canShoot = false;
-			this->Betty.ShootBullet(this->BulletsBetty.at(this->Betty.bulletIndex % MAX_BULLETS));
-			this->Betty.bulletIndex++;
+			this->Betty.ShootBullet(this->BulletsBetty, SPRITE_BULLET_BETTY, this->sprites[SPRITE_BULLET_BETTY]);
 			Mix_PlayChannel(-1, fireSound, 0);
 		}
 	}
@@ -761,47 +1269,47 @@ void GameState::ProcessEvents() {
 	this->George.velocity.x = 0.0f;
 	this->George.velocity.y = 0.0f;
 	if (!this->George.dead) {
-		if (keys[SDL_SCANCODE_A]) {
+		if (this->Held(BUTTON_GEORGE_LEFT)) {
 			if (this->George.position.x > -1.22f) {
 				this->George.velocity.x = -1.0f;
 			}
-			if (!keys[SDL_SCANCODE_G]) {
+			if (!this->Held(BUTTON_GEORGE_STRAFE)) {
 				this->George.faceDirection = LEFT;
 			}
 		}
-		if (keys[SDL_SCANCODE_D]) {
+		if (this->Held(BUTTON_GEORGE_RIGHT)) {
 			if (this->George.position.x < 1.27f) {
 				this->George.velocity.x = 1.0f;
 			}
-			if (!keys[SDL_SCANCODE_G]) {
+			if (!this->Held(BUTTON_GEORGE_STRAFE)) {
 				this->George.faceDirection = RIGHT;
 			}
 		}
-		if (keys[SDL_SCANCODE_W]) {
+		if (this->Held(BUTTON_GEORGE_UP)) {
 			if (this->George.position.y + this->George.sprite.height / 2 < 1.777f) {
 				this->George.velocity.y = 1.0f;
 			}
-			if (!keys[SDL_SCANCODE_G]) {
+			if (!this->Held(BUTTON_GEORGE_STRAFE)) {
 				this->George.faceDirection = UP;
 			}
 		}
-		if (keys[SDL_SCANCODE_S]) {
+		if (this->Held(BUTTON_GEORGE_DOWN)) {
 			if (this->George.position.y - this->George.sprite.height / 2 > -1.777f) {
 				this->George.velocity.y = -1.0f;
 			}
-			if (!keys[SDL_SCANCODE_G]) {
+			if (!this->Held(BUTTON_GEORGE_STRAFE)) {
 				this->George.faceDirection = DOWN;
 			}
 		}
-		if (!keys[SDL_SCANCODE_A] &&
-			!keys[SDL_SCANCODE_D] &&
-			!keys[SDL_SCANCODE_W] &&
-			!keys[SDL_SCANCODE_S]) {
+		if (!this->Held(BUTTON_GEORGE_LEFT) &&
+			!this->Held(BUTTON_GEORGE_RIGHT) &&
+			!this->Held(BUTTON_GEORGE_UP) &&
+			!this->Held(BUTTON_GEORGE_DOWN)) {
 			this->George.moveCounter = 0.0f;
 		}
 		else {
-			if (this->George.moveDirection == this->George.faceDirection || keys[SDL_SCANCODE_G]) {
-				this->George.moveCounter += 0.005f;
+			if (this->George.moveDirection == this->George.faceDirection || this->Held(BUTTON_GEORGE_STRAFE)) {
+				this->George.moveCounter += 0.3f * fixedTimestep;
 			}
 			else {
 				this->George.moveCounter = 0.0f;
@@ -824,35 +1332,27 @@ void GameState::ProcessEvents() {
 			break;
 		}
 
-		if (keys[SDL_SCANCODE_F] && this->George.canShoot) {
+		if (this->Held(BUTTON_GEORGE_FIRE) && this->George.canShoot) {
 			this->George.canShoot = false;
-			this->George.ShootBullet(this->BulletsGeorge.at(this->George.bulletIndex % MAX_BULLETS));
-			this->George.bulletIndex++;
+			this->George.ShootBullet(this->BulletsGeorge, SPRITE_BULLET_GEORGE, this->sprites[SPRITE_BULLET_GEORGE]);
 			Mix_PlayChannel(-1, fireSound, 0);
 		}
 	}
 }
 
 void GameOverState::ProcessEvents() {
-	SDL_Event event;
-	while (SDL_PollEvent(&event)) {
-		if (event.type == SDL_QUIT || event.type == SDL_WINDOWEVENT_CLOSE) {
-			done = true;
-		}
-	}
-	if (event.type == SDL_MOUSEBUTTONDOWN) {
+	inputQueue.BeginTick();
+	int x, y;
+	if (inputQueue.Clicked(&x, &y)) {
 		// Get coordinates of where the user clicked
-		float cursorX = (((float)event.button.x / 640.0f) * 3.554f) - 1.777f;
-		float cursorY = (((float)(640.0f - event.button.y) / 640.0f) * 3.554f) - 1.777f;
+		float cursorX = (((float)x / 640.0f) * 3.554f) - 1.777f;
+		float cursorY = (((float)(640.0f - y) / 640.0f) * 3.554f) - 1.777f;
 
 		if (clicked(playAgainButton, cursorX, cursorY)) {
-			Mix_PlayMusic(backgroundMusic, 1);
-			mode = GAME_LEVEL;
-			gameState.Setup();
+			EnterMode(GAME_LEVEL);
 		}
 		else if (clicked(mainMenuButton, cursorX, cursorY)) {
-			mode = MAIN_MENU;
-			mainMenuState.Setup();
+			EnterMode(MAIN_MENU);
 		}
 		else if (clicked(quitButton, cursorX, cursorY)) {
 			done = true;
@@ -861,55 +1361,104 @@ void GameOverState::ProcessEvents() {
 }
 
 void ProcessEvents() {
+	inputQueue.Poll();
+	const vector<InputEvent> &events = inputQueue.Polled();
+	for (size_t i = 0; i < events.size(); i++) {
+		ProcessCommonEvent(events[i].event);
+	}
+	// The level takes its input at the start of every tick, in GameState::Update()
 	switch (mode) {
 	case MAIN_MENU:
 		mainMenuState.ProcessEvents();
 		break;
-	case GAME_LEVEL:
-		gameState.ProcessEvents();
-		break;
 	case GAME_OVER:
 		gameOverState.ProcessEvents();
 	}
 }
 
+// Reports how the replay ended and quits
+void EndReplay(GameState &state, unsigned int ticks) {
+	double seconds = (double)(SDL_GetPerformanceCounter() - replayStart) / SDL_GetPerformanceFrequency();
+	double gameSeconds = ticks * replay.timestep;
+	std::cout << "Replay finished after " << ticks << " ticks (" << gameSeconds << " s of play) in " << seconds * 1000.0 << " ms";
+	if (seconds > 0.0) {
+		std::cout << ", " << gameSeconds / seconds << "x real time";
+	}
+	std::cout << "\nBetty " << state.Betty.playerScore << ", George " << state.George.playerScore << "\n";
+	done = true;
+}
+
 void GameState::Update(float elapsed) {
+	TRACE_SCOPE("Tick");
+	inputQueue.BeginTick();
+	// The buttons come from the replay when one is playing, otherwise from the benchmark bots or the keyboard
+	if (playingReplay) {
+		if (!replay.Next(this->buttons)) {
+			EndReplay(*this, replay.ticks);
+			return;
+		}
+	}
+	else {
+		if (benchmark.active || stress.active) {
+			this->buttons = BotButtons(benchmark.active ? benchmark.frame : stress.frame);
+		}
+		else {
+			this->buttons = ReadButtons();
+		}
+		if (recordPath != NULL) {
+			replay.Record(this->buttons);
+		}
+	}
+	if (stress.active) {
+		this->FillTo(stress.step * STRESS_ENEMIES_PER_STEP, stress.step * STRESS_BULLETS_PER_STEP, stress.step * STRESS_PARTICLES_PER_STEP);
+	}
+
+	this->Betty.previousPosition = this->Betty.position;
+	this->George.previousPosition = this->George.position;
+	this->ProcessInput();
+
 	if (this->Betty.dead && this->George.dead) {
-		this->BulletsBetty.clear();
-		this->BulletsGeorge.clear();
-		this->particles.clear();
-		this->enemies.clear();
+		this->BulletsBetty.Clear();
+		this->BulletsGeorge.Clear();
+		this->particles.Clear();
+		this->enemies.Clear();
 
-		mode = GAME_OVER;
-		gameOverState.Setup();
+		if (playingReplay) {
+			EndReplay(*this, replay.ticks);
+		}
+		else if (recordPath != NULL) {
+			replay.Save(recordPath);
+		}
+
+		EnterMode(GAME_OVER);
 	}
 
 	if (!this->Betty.dead && !this->George.dead) {
 		if (Betty.CollidesWith(George)) {
-			if (keys[SDL_SCANCODE_RIGHT] && this->Betty.collidedRight) {
+			if (this->Held(BUTTON_BETTY_RIGHT) && this->Betty.collidedRight) {
 				this->Betty.velocity.x = 0.0f;
 			}
-			if (keys[SDL_SCANCODE_LEFT] && this->Betty.collidedLeft) {
+			if (this->Held(BUTTON_BETTY_LEFT) && this->Betty.collidedLeft) {
 				this->Betty.velocity.x = 0.0f;
 			}
-			if (keys[SDL_SCANCODE_UP] && this->Betty.collidedBottom) {
+			if (this->Held(BUTTON_BETTY_UP) && this->Betty.collidedBottom) {
 				this->Betty.velocity.y = 0.0f;
 			}
-			if (keys[SDL_SCANCODE_DOWN] && this->Betty.collidedTop) {
+			if (this->Held(BUTTON_BETTY_DOWN) && this->Betty.collidedTop) {
 				this->Betty.velocity.y = 0.0f;
 			}
 		}
 		if (George.CollidesWith(Betty)) {
-			if (keys[SDL_SCANCODE_D] && this->George.collidedRight) {
+			if (this->Held(BUTTON_GEORGE_RIGHT) && this->George.collidedRight) {
 				this->George.velocity.x = 0.0f;
 			}
-			if (keys[SDL_SCANCODE_A] && this->George.collidedLeft) {
+			if (this->Held(BUTTON_GEORGE_LEFT) && this->George.collidedLeft) {
 				this->George.velocity.x = 0.0f;
 			}
-			if (keys[SDL_SCANCODE_W] && this->George.collidedBottom) {
+			if (this->Held(BUTTON_GEORGE_UP) && this->George.collidedBottom) {
 				this->George.velocity.y = 0.0f;
 			}
-			if (keys[SDL_SCANCODE_S] && this->George.collidedTop) {
+			if (this->Held(BUTTON_GEORGE_DOWN) && this->George.collidedTop) {
 				this->George.velocity.y = 0.0f;
 			}
 		}
@@ -934,87 +1483,214 @@ void GameState::Update(float elapsed) {
 		this->George.shootCounter = 0.0f;
 	}
 
-	for (int i = 0; i < this->BulletsBetty.size(); i++) {
-		this->BulletsBetty.at(i).Update(elapsed);
-		for (int j = 0; j < this->enemies.size(); j++) {
-			if (this->BulletsBetty.at(i).CollidesWith(this->enemies.at(j))) {
-				this->CreateBoom(this->particleBetty, this->BulletsBetty.at(i).position.x, this->BulletsBetty.at(i).position.y);
-				this->Betty.playerScore++;
-				this->BulletsBetty.at(i).position = glm::vec3(-1000.0f, 0.0f, 0.0f);
-				this->BulletsBetty.at(i).velocity = glm::vec3(0.0f, 0.0f, 0.0f);
-				this->enemies.erase(this->enemies.begin() + j);
-			}
-		}
-		if (this->BulletsBetty.at(i).CollidesWith(this->George) && !this->George.dead) {
-			this->George.sprite = skull;
-			this->George.dead = true;
-			this->BulletsBetty.at(i).position = glm::vec3(-1000.0f, 0.0f, 0.0f);
-			this->BulletsBetty.at(i).velocity = glm::vec3(0.0f, 0.0f, 0.0f);
-		}
+	this->UpdateBullets(this->BulletsBetty, this->Betty, this->George, SPRITE_PARTICLE_BETTY, elapsed);
+	this->UpdateBullets(this->BulletsGeorge, this->George, this->Betty, SPRITE_PARTICLE_GEORGE, elapsed);
+
+	size_t activeBullets = this->BulletsBetty.Count() + this->BulletsGeorge.Count();
+	this->bulletTicks++;
+	this->bulletSum += activeBullets;
+	this->bulletPeak = std::max(this->bulletPeak, activeBullets);
+
+	this->particles.Update(elapsed);
+
+	// A stress test holds its own enemy count
+	this->spawnRate += elapsed;
+	if (this->spawnRate > 4.0f && !stress.active) {
+		this->spawnRate = 0.0f;
+		this->numberOfEnemies++;
+		this->enemySpeed += 0.05f;
+		this->SpawnEnemies();
 	}
-	for (int i = 0; i < this->BulletsGeorge.size(); i++) {
-		this->BulletsGeorge.at(i).Update(elapsed);
-		for (int j = 0; j < this->enemies.size(); j++) {
-			if (this->BulletsGeorge.at(i).CollidesWith(this->enemies.at(j))) {
-				this->CreateBoom(this->particleGeorge, this->BulletsGeorge.at(i).position.x, this->BulletsGeorge.at(i).position.y);
-				this->George.playerScore++;
-				this->BulletsGeorge.at(i).position = glm::vec3(1000.0f, 0.0f, 0.0f);
-				this->BulletsGeorge.at(i).velocity = glm::vec3(0.0f, 0.0f, 0.0f);
-				this->enemies.erase(this->enemies.begin() + j);
+
+	// Enemies are moved and tested against both players in chunks. Each chunk covers whole
+	// mask words, so the jobs never write to the same word.
+	size_t numEnemies = this->enemies.Count();
+	size_t maskWords = BOX_MASK_WORDS(numEnemies);
+	ArenaVector<unsigned int> hitMask(2 * maskWords);
+	Player *players[] = { &this->Betty, &this->George };
+	{
+		TRACE_SCOPE("Enemies vs players");
+		jobSystem.ParallelFor(numEnemies, ENEMY_CHUNK, [&](size_t begin, size_t end, int worker) {
+			this->enemies.Update(elapsed, begin, end);
+			for (int p = 0; p < 2; p++) {
+				Player &player = *players[p];
+				OverlapBoxes(player.position.x, player.position.y, player.sprite.width * player.size.x, player.sprite.height * player.size.y,
+					this->enemies.x.data() + begin, this->enemies.y.data() + begin, this->enemies.halfWidth.data() + begin, this->enemies.halfHeight.data() + begin,
+					end - begin, hitMask.data() + p * maskWords + begin / 32);
 			}
+		});
+	}
+	for (int p = 0; p < 2; p++) {
+		if (!invulnerable && FirstHit(hitMask.data() + p * maskWords, numEnemies) >= 0) {
+			players[p]->sprite = this->skull;
+			players[p]->dead = true;
 		}
-		if (this->BulletsGeorge.at(i).CollidesWith(this->Betty) && !this->Betty.dead) {
-			this->Betty.sprite = skull;
-			this->Betty.dead = true;
-			this->BulletsGeorge.at(i).position = glm::vec3(1000.0f, 0.0f, 0.0f);
-			this->BulletsGeorge.at(i).velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+	}
+	for (size_t i = this->enemies.Count(); i-- > 0;) {
+		if (this->enemies.y[i] < -2.0f || this->enemies.y[i] > 2.0f) {
+			this->enemies.Remove(i);
 		}
 	}
-	for (int i = 0; i < this->particles.size(); i++) {
-		if (this->particles.at(i).size.x < 0.4f) {
-			this->particles.at(i).size.x += 0.004f;
-			this->particles.at(i).size.y += 0.004f;
-		} else {
-			this->particles.erase(this->particles.begin() + i);
+	TRACE_COUNTER("Enemy count", this->enemies.Count());
+	TRACE_COUNTER("Bullet count", activeBullets);
+	TRACE_COUNTER("Particle count", this->particles.LiveCount());
+}
+
+// Moves one player's bullets, then resolves hits against the enemies and the other player.
+// Each bullet is swept along its move this tick, so a fast bullet or a slow tick rate can't
+// carry it through a target between two positions. The SIMD OverlapBoxes() kernel picks the
+// enemies near the move and only those are swept. When a bullet could hit both an enemy and
+// the other player, the earlier time of impact wins.
+//
+// The sweeps run as jobs against the enemies as they were at the start of the call and only
+// record hits. The hits are then merged in bullet order and applied on this thread, so score,
+// explosions and deaths come out the same for any number of workers. When two bullets reach
+// the same enemy, the lower bullet index gets it and the other is swept again against the
+// enemies still unclaimed, so it can hit the next one on its path in the same tick.
+// Spent bullets, and bullets that left the arena, are removed from the active list.
+void GameState::UpdateBullets(EntityArrays &bullets, Player &shooter, Player &target, int particleSprite, float elapsed) {
+	TRACE_SCOPE("UpdateBullets");
+	if (bullets.Count() == 0) {
+		return;
+	}
+	bullets.Update(elapsed);
+
+	float targetHalfWidth = target.sprite.width * target.size.x;
+	float targetHalfHeight = target.sprite.height * target.size.y;
+	float targetDeltaX = target.position.x - target.previousPosition.x;
+	float targetDeltaY = target.position.y - target.previousPosition.y;
+	bool targetAlive = !target.dead;
+
+	this->bulletHits.resize(jobSystem.WorkerCount());
+	for (size_t w = 0; w < this->bulletHits.size(); w++) {
+		this->bulletHits[w].clear();
+	}
+	// Each worker's scratch mask for the SIMD broadphase of its sweeps
+	size_t maskWords = BOX_MASK_WORDS(this->enemies.Count());
+	ArenaVector<unsigned int> sweepMasks(jobSystem.WorkerCount() * maskWords);
+
+	jobSystem.ParallelFor(bullets.Count(), BULLET_CHUNK, [&](size_t begin, size_t end, int worker) {
+		for (size_t i = begin; i < end; i++) {
+			float startX = bullets.previousX[i];
+			float startY = bullets.previousY[i];
+			float deltaX = bullets.x[i] - startX;
+			float deltaY = bullets.y[i] - startY;
+
+			// Enemies move after the bullets, so they are still where this tick started
+			BulletHit hit;
+			hit.bullet = (int)i;
+			hit.enemy = FirstSweptHit(startX, startY, bullets.halfWidth[i], bullets.halfHeight[i], deltaX, deltaY,
+				this->enemies.x.data(), this->enemies.y.data(), this->enemies.halfWidth.data(), this->enemies.halfHeight.data(),
+				this->enemies.Count(), NULL, sweepMasks.data() + worker * maskWords, &hit.enemyTime);
+
+			// The players have already moved, so sweep against the target's motion as well
+			hit.targetTime = -1.0f;
+			if (targetAlive) {
+				hit.targetTime = SweepBox(startX, startY, bullets.halfWidth[i], bullets.halfHeight[i], deltaX - targetDeltaX, deltaY - targetDeltaY,
+					target.previousPosition.x, target.previousPosition.y, targetHalfWidth, targetHalfHeight);
+			}
+
+			if (hit.enemy >= 0 || hit.targetTime >= 0.0f) {
+				this->bulletHits[worker].push_back(hit);
+			}
 		}
+	});
+
+	// Merge the per-worker buffers in bullet order
+	size_t hitCount = 0;
+	for (size_t w = 0; w < this->bulletHits.size(); w++) {
+		hitCount += this->bulletHits[w].size();
 	}
-	this->spawnRate += elapsed;
-	if (this->spawnRate > 4.0f) {
-		this->spawnRate = 0.0f;
-		this->numberOfEnemies++;
-		this->enemySpeed += 0.05f;
-		this->SpawnEnemies();
+	ArenaVector<BulletHit> mergedHits;
+	mergedHits.reserve(hitCount);
+	for (size_t w = 0; w < this->bulletHits.size(); w++) {
+		mergedHits.insert(mergedHits.end(), this->bulletHits[w].begin(), this->bulletHits[w].end());
 	}
-	for (int i = 0; i < this->enemies.size(); i++) {
-		this->enemies.at(i).Update(elapsed);
-		if (this->enemies.at(i).CollidesWith(this->Betty)) {
-			this->Betty.sprite = this->skull;
-			this->Betty.dead = true;
+	std::sort(mergedHits.begin(), mergedHits.end(), [](const BulletHit &a, const BulletHit &b) { return a.bullet < b.bullet; });
+
+	ArenaVector<char> enemyClaimed(this->enemies.Count(), 0);
+	ArenaVector<char> bulletSpent(bullets.Count(), 0);
+	for (size_t h = 0; h < mergedHits.size(); h++) {
+		BulletHit &hit = mergedHits[h];
+		size_t i = hit.bullet;
+		if (hit.enemy >= 0 && enemyClaimed[hit.enemy]) {
+			// A lower bullet took this enemy, so sweep again for the next one along the path
+			float startX = bullets.previousX[i];
+			float startY = bullets.previousY[i];
+			hit.enemy = FirstSweptHit(startX, startY, bullets.halfWidth[i], bullets.halfHeight[i], bullets.x[i] - startX, bullets.y[i] - startY,
+				this->enemies.x.data(), this->enemies.y.data(), this->enemies.halfWidth.data(), this->enemies.halfHeight.data(),
+				this->enemies.Count(), enemyClaimed.data(), sweepMasks.data(), &hit.enemyTime);
+		}
+		bool enemyFree = hit.enemy >= 0;
+		if (hit.targetTime >= 0.0f && !target.dead && !invulnerable && (!enemyFree || hit.targetTime < hit.enemyTime)) {
+			target.sprite = skull;
+			target.dead = true;
+			bulletSpent[i] = 1;
+		} else if (enemyFree) {
+			float startX = bullets.previousX[i];
+			float startY = bullets.previousY[i];
+			this->CreateBoom(particleSprite, startX + (bullets.x[i] - startX) * hit.enemyTime, startY + (bullets.y[i] - startY) * hit.enemyTime);
+			shooter.playerScore++;
+			bulletSpent[i] = 1;
+			enemyClaimed[hit.enemy] = 1;
 		}
-		if (this->enemies.at(i).CollidesWith(this->George)) {
-			this->George.sprite = this->skull;
-			this->George.dead = true;
+	}
+
+	// Remove from the highest index down so swap-and-pop never moves a claimed enemy
+	for (size_t j = enemyClaimed.size(); j-- > 0;) {
+		if (enemyClaimed[j]) {
+			this->enemies.Remove(j);
 		}
-		if (this->enemies.at(i).position.y < -2.0f || this->enemies.at(i).position.y > 2.0f) {
-			this->enemies.erase(this->enemies.begin() + i);
+	}
+	for (size_t i = bullets.Count(); i-- > 0;) {
+		if (bulletSpent[i] || fabsf(bullets.x[i]) > ARENA_EDGE || fabsf(bullets.y[i]) > ARENA_EDGE) {
+			bullets.Remove(i);
 		}
 	}
 }
 
-void Update() {
-	float ticks = (float) SDL_GetTicks() / 1000.0f;
-	float elapsed = ticks - lastFrameTicks;
-	lastFrameTicks = ticks;
+void Update(float elapsed) {
+	// The next game is reset while the game over screen is up, the frame after the last one
+	// ended, so Play Again has nothing left to do
+	if (mode == GAME_OVER && !gameState.ready && !done) {
+		TRACE_SCOPE("Prepare next game");
+		gameState.Reset();
+	}
 
-	switch (mode) {
-	case GAME_LEVEL:
-		gameState.Update(elapsed);
-		break;
+	// Run the simulation in fixed steps so its speed doesn't depend on the frame rate.
+	// After a long frame only MAX_TIMESTEPS steps are run and the rest of the time is dropped,
+	// so a hitch never makes entities jump or speed up to catch up.
+	if (fastReplay && mode == GAME_LEVEL) {
+		// Fill about a 60 Hz frame with ticks and only draw the last one
+		Uint64 frameEnd = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() / 60;
+		while (mode == GAME_LEVEL && !done && SDL_GetPerformanceCounter() < frameEnd) {
+			gameState.Update(fixedTimestep);
+		}
+		accumulator = 0.0f;
+		return;
+	}
+
+	accumulator += elapsed;
+	int steps = 0;
+	while (accumulator >= fixedTimestep && steps < MAX_TIMESTEPS) {
+		switch (mode) {
+		case GAME_LEVEL:
+			gameState.Update(fixedTimestep);
+			break;
+		}
+		accumulator -= fixedTimestep;
+		steps++;
+	}
+	if (accumulator >= fixedTimestep) {
+		accumulator = 0.0f;
 	}
 }
 
 void MainMenuState::Render() {
+	TRACE_SCOPE("Menu");
+	glStats.BeginPass("Menu");
 	setBackgroundTexture(this->backgroundTexture);
+	gpuTimer.BeginPass("UI");
 
 	glm::mat4 modelMatrix = glm::mat4(1.0f);
 	modelMatrix = glm::translate(modelMatrix, glm::vec3(-0.85f, 0.75f, 0.0f));
@@ -1035,33 +1711,51 @@ void MainMenuState::Render() {
 	DrawText(texturedProgram, asciiSpriteSheetTexture, "Quit", 0.15f, -0.07f);
 }
 
-void GameState::Render() {
-	setBackgroundTexture(this->backgroundTexture);
-	this->Betty.Render(texturedProgram);
-	this->George.Render(texturedProgram);
-	for (int i = 0; i < this->BulletsBetty.size(); i++) {
-		this->BulletsBetty.at(i).Render(texturedProgram);
+void GameState::Render(float alpha) {
+	{
+		TRACE_SCOPE("Background");
+		glStats.BeginPass("Background");
+		setBackgroundTexture(this->backgroundTexture);
+	}
+	{
+		TRACE_SCOPE("Players");
+		glStats.BeginPass("Players");
+		gpuTimer.BeginPass("Sprites");
+		this->Betty.Render(texturedProgram, alpha);
+		this->George.Render(texturedProgram, alpha);
 	}
-	for (int i = 0; i < this->BulletsGeorge.size(); i++) {
-		this->BulletsGeorge.at(i).Render(texturedProgram);
+	{
+		TRACE_SCOPE("Bullets");
+		glStats.BeginPass("Bullets");
+		this->BulletsBetty.Render(texturedProgram, this->sprites, alpha);
+		this->BulletsGeorge.Render(texturedProgram, this->sprites, alpha);
 	}
-	for (int i = 0; i < this->particles.size(); i++) {
-		this->particles.at(i).Render(texturedProgram);
+	{
+		TRACE_SCOPE("Particles");
+		glStats.BeginPass("Particles");
+		gpuTimer.BeginPass("Particles");
+		this->particles.Render(particleProgram, particleFadeAttribute, this->sprites, alpha);
 	}
-	for (int i = 0; i < this->enemies.size(); i++) {
-		this->enemies.at(i).Render(texturedProgram);
+	{
+		TRACE_SCOPE("Enemies");
+		glStats.BeginPass("Enemies");
+		gpuTimer.BeginPass("Sprites");
+		this->enemies.Render(texturedProgram, this->sprites, alpha);
 	}
 }
 
 void GameOverState::Render() {
+	TRACE_SCOPE("Game Over");
+	glStats.BeginPass("Game Over");
 	setBackgroundTexture(this->backgroundTexture);
+	gpuTimer.BeginPass("UI");
 
 	glm::mat4 modelMatrix = glm::mat4(1.0f);
 	modelMatrix = glm::translate(modelMatrix, glm::vec3(-0.71f, 1.0f, 0.0f));
 	texturedProgram.SetModelMatrix(modelMatrix);
-	if (gameState.Betty.playerScore > gameState.George.playerScore) {
+	if (this->bettyScore > this->georgeScore) {
 		DrawText(texturedProgram, asciiSpriteSheetTexture, "Betty wins!", 0.3f, -0.16f);
-	} else if (gameState.Betty.playerScore < gameState.George.playerScore){
+	} else if (this->bettyScore < this->georgeScore){
 		DrawText(texturedProgram, asciiSpriteSheetTexture, "George wins!", 0.3f, -0.16f);
 	} else {
 		DrawText(texturedProgram, asciiSpriteSheetTexture, "It's a tie!", 0.3f, -0.16f);
@@ -1070,13 +1764,17 @@ void GameOverState::Render() {
 	modelMatrix = glm::mat4(1.0f);
 	modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, 1.6f, 0.0f));
 	texturedProgram.SetModelMatrix(modelMatrix);
-	DrawText(texturedProgram, asciiSpriteSheetTexture, "Betty's Score: " + to_string(gameState.Betty.playerScore), 0.2f, -0.125f);
+	ArenaStringStream score;
+	score << "Betty's Score: " << this->bettyScore;
+	DrawText(texturedProgram, asciiSpriteSheetTexture, score.str().c_str(), 0.2f, -0.125f);
 
 	// Render George's score (top right corner)
 	modelMatrix = glm::mat4(1.0f);
 	modelMatrix = glm::translate(modelMatrix, glm::vec3(0.4f, 1.6f, 0.0f));
 	texturedProgram.SetModelMatrix(modelMatrix);
-	DrawText(texturedProgram, asciiSpriteSheetTexture, "George's Score: " + to_string(gameState.George.playerScore), 0.2f, -0.125f);
+	score.str("");
+	score << "George's Score: " << this->georgeScore;
+	DrawText(texturedProgram, asciiSpriteSheetTexture, score.str().c_str(), 0.2f, -0.125f);
 
 	playAgainButton.Render(texturedProgram);
 	mainMenuButton.Render(texturedProgram);
@@ -1101,34 +1799,265 @@ void GameOverState::Render() {
 	DrawText(texturedProgram, asciiSpriteSheetTexture, "Quit", 0.15f, -0.07f);
 }
 
+// Stacked bar per frame in the profiler graph, one color per phase
+const float PROFILER_COLORS[NUM_PHASES][3] = {
+	{ 0.3f, 0.6f, 1.0f },	// Events
+	{ 1.0f, 0.6f, 0.2f },	// Update
+	{ 0.3f, 0.9f, 0.3f },	// Render
+	{ 0.9f, 0.3f, 0.9f }	// Swap
+};
+#define PROFILER_MS_HEIGHT 0.05f	// Graph height of one millisecond
+
+// Per-phase percentiles, entity counts and a graph of the last PROFILER_HISTORY frames
+void RenderProfiler() {
+	ArenaStringStream text;
+	text << std::fixed << std::setprecision(2);
+	float lineY = 1.7f;
+
+	glm::mat4 modelMatrix = glm::mat4(1.0f);
+	modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, lineY, 0.0f));
+	texturedProgram.SetModelMatrix(modelMatrix);
+	DrawText(texturedProgram, asciiSpriteSheetTexture, "ms       p50   p95   p99", 0.08f, -0.035f);
+
+	for (int phase = 0; phase <= NUM_PHASES; phase++) {
+		text.str("");
+		text << std::left << std::setw(7) << PROFILER_PHASE_NAMES[phase] << std::right
+			<< std::setw(6) << profiler.Percentile(phase, 50.0f)
+			<< std::setw(6) << profiler.Percentile(phase, 95.0f)
+			<< std::setw(6) << profiler.Percentile(phase, 99.0f);
+		lineY -= 0.1f;
+		modelMatrix = glm::mat4(1.0f);
+		modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, lineY, 0.0f));
+		texturedProgram.SetModelMatrix(modelMatrix);
+		DrawText(texturedProgram, asciiSpriteSheetTexture, text.str().c_str(), 0.08f, -0.035f);
+	}
+
+	if (mode == GAME_LEVEL) {
+		text.str("");
+		text << "Enemies " << gameState.enemies.Count()
+			<< "  Bullets " << gameState.BulletsBetty.Count() + gameState.BulletsGeorge.Count()
+			<< "  Particles " << gameState.particles.LiveCount();
+		lineY -= 0.1f;
+		modelMatrix = glm::mat4(1.0f);
+		modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, lineY, 0.0f));
+		texturedProgram.SetModelMatrix(modelMatrix);
+		DrawText(texturedProgram, asciiSpriteSheetTexture, text.str().c_str(), 0.08f, -0.035f);
+	}
+
+	// GL calls of the last frame: draws, vertices, KB of vertex data, texture and program binds, uniforms
+	if (glStats.enabled) {
+		lineY -= 0.1f;
+		modelMatrix = glm::mat4(1.0f);
+		modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, lineY, 0.0f));
+		texturedProgram.SetModelMatrix(modelMatrix);
+		DrawText(texturedProgram, asciiSpriteSheetTexture, "GL          draw  vert    KB  tex prog  unif", 0.08f, -0.035f);
+		for (int i = 0; i <= glStats.passCount; i++) {
+			const GLCounts &counts = i < glStats.passCount ? glStats.last[i] : glStats.lastTotal;
+			if (counts.drawCalls == 0 && i < glStats.passCount) {
+				continue;
+			}
+			text.str("");
+			text << std::left << std::setw(11) << (i < glStats.passCount ? glStats.passNames[i] : "Total") << std::right << std::setprecision(1)
+				<< std::setw(5) << counts.drawCalls << std::setw(6) << counts.vertices << std::setw(6) << counts.bytes / 1024.0f
+				<< std::setw(5) << counts.textureBinds << std::setw(5) << counts.programBinds << std::setw(6) << counts.uniforms;
+			lineY -= 0.1f;
+			modelMatrix = glm::mat4(1.0f);
+			modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, lineY, 0.0f));
+			texturedProgram.SetModelMatrix(modelMatrix);
+			DrawText(texturedProgram, asciiSpriteSheetTexture, text.str().c_str(), 0.08f, -0.035f);
+		}
+	}
+
+	// GPU time of each pass, a few frames old since the queries are read back late
+	if (gpuTimer.enabled && gpuTimer.lastFrame >= 0) {
+		lineY -= 0.1f;
+		modelMatrix = glm::mat4(1.0f);
+		modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, lineY, 0.0f));
+		texturedProgram.SetModelMatrix(modelMatrix);
+		DrawText(texturedProgram, asciiSpriteSheetTexture, "GPU ms", 0.08f, -0.035f);
+		for (int i = 0; i <= gpuTimer.passCount; i++) {
+			text.str("");
+			text << std::left << std::setw(11) << (i < gpuTimer.passCount ? gpuTimer.passNames[i] : "Total") << std::right << std::setprecision(2)
+				<< std::setw(6) << (i < gpuTimer.passCount ? gpuTimer.lastMs[i] : gpuTimer.lastTotalMs);
+			lineY -= 0.1f;
+			modelMatrix = glm::mat4(1.0f);
+			modelMatrix = glm::translate(modelMatrix, glm::vec3(-1.7f, lineY, 0.0f));
+			texturedProgram.SetModelMatrix(modelMatrix);
+			DrawText(texturedProgram, asciiSpriteSheetTexture, text.str().c_str(), 0.08f, -0.035f);
+		}
+	}
+
+	// Newest frame on the right, phases stacked from the bottom up
+	float *bars = frameArena.AllocateArray<float>(PROFILER_HISTORY * 12);
+	float barWidth = 3.4f / PROFILER_HISTORY;
+	glUseProgram(program.programID);
+	program.SetModelMatrix(glm::mat4(1.0f));
+	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, bars);
+	glEnableVertexAttribArray(program.positionAttribute);
+	for (int phase = 0; phase < NUM_PHASES; phase++) {
+		for (int age = 0; age < profiler.FrameCount(); age++) {
+			float bottom = -1.7f;
+			for (int below = 0; below < phase; below++) {
+				bottom += profiler.PhaseMs(below, age) * PROFILER_MS_HEIGHT;
+			}
+			float top = bottom + profiler.PhaseMs(phase, age) * PROFILER_MS_HEIGHT;
+			float right = 1.7f - age * barWidth;
+			float left = right - barWidth;
+			float quad[] = { left, bottom, right, bottom, right, top, left, bottom, right, top, left, top };
+			std::copy(quad, quad + 12, bars + age * 12);
+		}
+		program.SetColor(PROFILER_COLORS[phase][0], PROFILER_COLORS[phase][1], PROFILER_COLORS[phase][2], 0.8f);
+		glDrawArrays(GL_TRIANGLES, 0, 6 * profiler.FrameCount());
+	}
+
+	// Line at a 60 Hz frame budget
+	float budget = -1.7f + 1000.0f / 60.0f * PROFILER_MS_HEIGHT;
+	float line[] = { -1.7f, budget, 1.7f, budget, 1.7f, budget + 0.01f, -1.7f, budget, 1.7f, budget + 0.01f, -1.7f, budget + 0.01f };
+	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, line);
+	program.SetColor(1.0f, 1.0f, 1.0f, 0.8f);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glDisableVertexAttribArray(program.positionAttribute);
+}
+
+// Swapping is left to the main loop so the profiler can time it on its own.
+// On the GPU the clear is timed with the background, the sprites and particles in their own
+// passes and the menus' buttons and text, and the profiler overlay, as UI.
 void Render() {
+	gpuTimer.BeginPass("Background");
 	glClear(GL_COLOR_BUFFER_BIT);
 	switch (mode) {
 	case MAIN_MENU:
 		mainMenuState.Render();
 		break;
 	case GAME_LEVEL:
-		gameState.Render();
+		// Draw between the last two ticks by the fraction of a tick left in the accumulator
+		gameState.Render(accumulator / fixedTimestep);
 		break;
 	case GAME_OVER:
 		gameOverState.Render();
 		break;
 	}
-	SDL_GL_SwapWindow(displayWindow);
+	if (showProfiler) {
+		TRACE_SCOPE("Profiler");
+		glStats.BeginPass("Profiler");
+		gpuTimer.BeginPass("UI");
+		RenderProfiler();
+	}
 }
 
 void Cleanup() {
-	
+	// Keep a game that was still going when the window closed
+	if (recordPath != NULL && !playingReplay && mode == GAME_LEVEL) {
+		replay.Save(recordPath);
+	}
+	jobSystem.Shutdown();
 }
 
 int main(int argc, char *argv[]) {
+	for (int i = 1; i < argc; i++) {
+		if (string(argv[i]) == "--record" && i + 1 < argc) {
+			recordPath = argv[++i];
+		}
+		else if (string(argv[i]) == "--replay" && i + 1 < argc) {
+			if (!replay.Load(argv[++i])) {
+				return 1;
+			}
+			playingReplay = true;
+		}
+		else if (string(argv[i]) == "--fast") {
+			fastReplay = true;
+		}
+	}
+	if (benchmark.ParseArguments(argc, argv)) {
+		if (benchmark.scenario.compare(0, 4, "wave") == 0) {
+			benchmarkWave = atoi(benchmark.scenario.c_str() + 4);
+		}
+		if (benchmark.scenario != "menu" && benchmarkWave < 1) {
+			std::cout << "Unknown benchmark scenario " << benchmark.scenario << " (use menu or wave<N>, e.g. wave10)\n";
+			return 1;
+		}
+	}
+	else if (stress.ParseArguments(argc, argv) && (playingReplay || recordPath != NULL)) {
+		std::cout << "--stress can't be combined with --replay or --record\n";
+		return 1;
+	}
+
+	TraceSetup("alien_invasion_trace.json");
 	Setup();
 	while (!done) {
-		ProcessEvents();
-		Update();
-		Render();
+		TRACE_SCOPE("Frame");
+		float elapsed = framePacer.BeginFrame();
+		if (benchmark.active || stress.active) {
+			elapsed = fixedTimestep;	// One tick per frame, however long the frame took
+		}
+		profiler.BeginFrame();
+		frameArena.Reset();	// Scratch memory of the last frame is free again
+		{
+			// Scopes name the phase allocations are attributed to in debug builds
+			AllocScope scope("Events");
+			TRACE_SCOPE("Events");
+			ProcessEvents();
+		}
+		profiler.EndPhase(PHASE_EVENTS);
+		{
+			AllocScope scope("Update");
+			TRACE_SCOPE("Update");
+			Update(elapsed);
+		}
+		profiler.EndPhase(PHASE_UPDATE);
+		{
+			AllocScope scope("Render");
+			TRACE_SCOPE("Render");
+			Render();
+			gpuTimer.EndFrame();
+		}
+		profiler.EndPhase(PHASE_RENDER);
+		{
+			TRACE_SCOPE("Swap");
+			SDL_GL_SwapWindow(displayWindow);
+		}
+		profiler.EndPhase(PHASE_SWAP);
+		glStats.EndFrame();
+		profiler.EndFrame();
+		if (benchmark.active) {
+			benchmark.RecordFrame(profiler, glStats, &gpuTimer);
+			if (benchmark.Done()) {
+				done = true;
+			}
+		}
+		else if (stress.active) {
+			stress.RecordCount("enemies", (double)gameState.enemies.Count());
+			stress.RecordCount("bullets", (double)(gameState.BulletsBetty.Count() + gameState.BulletsGeorge.Count()));
+			stress.RecordCount("particles", (double)gameState.particles.LiveCount());
+			stress.RecordFrame(profiler);
+			if (stress.Done()) {
+				done = true;
+			}
+		}
+		{
+			TRACE_SCOPE("Pace");
+			framePacer.EndFrame();
+		}
     }
+	framePacer.PrintStats();
+	profiler.PrintStats();
+	frameArena.PrintStats();
+	inputQueue.PrintStats();
+	if (gameState.bulletTicks > 0) {
+		std::cout << "Bullets in flight: average " << (float)gameState.bulletSum / gameState.bulletTicks << ", peak " << gameState.bulletPeak << "\n";
+	}
+	if (transitions > 0) {
+		std::cout << "Screen switches: " << transitions << ", average " << transitionSumMs / transitions << " ms, slowest " << transitionMaxMs << " ms\n";
+	}
+	int result = 0;
+	if (benchmark.active) {
+		result = benchmark.Finish("Alien Invasion");
+	}
+	else if (stress.active) {
+		result = stress.Finish("Alien Invasion");
+	}
 	Cleanup();
+	TraceFlush();
 	SDL_Quit();
-    return 0;
+    return result;
 }
@@ -0,0 +1,18 @@
+attribute vec4 position;
+attribute vec2 texCoord;
+attribute float fade;
+
+uniform mat4 modelMatrix;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+varying vec2 texCoordVar;
+varying float fadeVar;
+
+void main()
+{
+	vec4 p = viewMatrix * modelMatrix  * position;
+    texCoordVar = texCoord;
+	fadeVar = fade;
+	gl_Position = projectionMatrix * p;
+}
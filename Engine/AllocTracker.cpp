@@ -0,0 +1,198 @@
+#include "AllocTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+std::atomic<long long> totalAllocations(0);
+std::atomic<long long> totalFrees(0);
+std::atomic<long long> totalBytes(0);
+
+#ifdef ALLOC_SITES
+struct AllocSite {
+	void *address;			// Return address of operator new, 0 for a free slot
+	const char *scope;
+	long long allocations;
+	long long bytes;
+};
+
+// Open addressing on the return address. The table is fixed so recording never allocates.
+AllocSite sites[ALLOC_SITES_MAX];
+std::atomic_flag sitesLock = ATOMIC_FLAG_INIT;
+std::atomic<bool> recordingSites(true);
+thread_local const char *currentScope = "";
+
+void RecordSite(void *address, size_t size) {
+	size_t hash = ((size_t)address >> 4) * 2654435761u;
+	while (sitesLock.test_and_set(std::memory_order_acquire)) {}
+	AllocSite *site = &sites[ALLOC_SITES_MAX - 1];
+	for (int probe = 0; probe < ALLOC_SITES_MAX - 1; probe++) {
+		AllocSite &candidate = sites[(hash + probe) % (ALLOC_SITES_MAX - 1)];
+		if (candidate.address == NULL || (candidate.address == address && candidate.scope == currentScope)) {
+			site = &candidate;
+			break;
+		}
+	}
+	site->address = address;
+	site->scope = currentScope;
+	site->allocations++;
+	site->bytes += size;
+	sitesLock.clear(std::memory_order_release);
+}
+#endif
+
+inline void *Allocate(size_t size, void *caller) {
+	void *memory = malloc(size != 0 ? size : 1);
+	if (memory != NULL) {
+		totalAllocations.fetch_add(1, std::memory_order_relaxed);
+		totalBytes.fetch_add((long long)size, std::memory_order_relaxed);
+#ifdef ALLOC_SITES
+		if (recordingSites.load(std::memory_order_relaxed)) {
+			RecordSite(caller, size);
+		}
+#endif
+	}
+	return memory;
+}
+
+inline void Free(void *memory) {
+	if (memory != NULL) {
+		totalFrees.fetch_add(1, std::memory_order_relaxed);
+		free(memory);
+	}
+}
+
+}
+
+#ifdef _MSC_VER
+#define CALLER_ADDRESS _ReturnAddress()
+#else
+#define CALLER_ADDRESS __builtin_return_address(0)
+#endif
+
+#ifndef NO_ALLOC_TRACKING
+void *operator new(size_t size) {
+	void *memory = Allocate(size, CALLER_ADDRESS);
+	if (memory == NULL) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void *operator new[](size_t size) {
+	void *memory = Allocate(size, CALLER_ADDRESS);
+	if (memory == NULL) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	return Allocate(size, CALLER_ADDRESS);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+	return Allocate(size, CALLER_ADDRESS);
+}
+
+void operator delete(void *memory) noexcept { Free(memory); }
+void operator delete[](void *memory) noexcept { Free(memory); }
+void operator delete(void *memory, size_t) noexcept { Free(memory); }
+void operator delete[](void *memory, size_t) noexcept { Free(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept { Free(memory); }
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { Free(memory); }
+#endif
+
+AllocCounts GetAllocCounts() {
+	AllocCounts counts;
+	counts.allocations = totalAllocations.load(std::memory_order_relaxed);
+	counts.frees = totalFrees.load(std::memory_order_relaxed);
+	counts.bytes = totalBytes.load(std::memory_order_relaxed);
+	return counts;
+}
+
+AllocCounts AllocDelta(const AllocCounts &from, const AllocCounts &to) {
+	AllocCounts delta;
+	delta.allocations = to.allocations - from.allocations;
+	delta.frees = to.frees - from.frees;
+	delta.bytes = to.bytes - from.bytes;
+	return delta;
+}
+
+AllocScope::AllocScope(const char *name) {
+	this->name = name;
+#ifdef ALLOC_SITES
+	parent = currentScope;
+	currentScope = name;
+#else
+	parent = NULL;
+#endif
+	start = GetAllocCounts();
+}
+
+AllocScope::~AllocScope() {
+#ifdef ALLOC_SITES
+	currentScope = parent;
+#endif
+}
+
+AllocCounts AllocScope::Counts() const {
+	return AllocDelta(start, GetAllocCounts());
+}
+
+void PrintAllocSites(int maxSites) {
+#ifdef ALLOC_SITES
+	// Copy the table out first, printing allocates
+	AllocSite copy[ALLOC_SITES_MAX];
+	while (sitesLock.test_and_set(std::memory_order_acquire)) {}
+	for (int i = 0; i < ALLOC_SITES_MAX; i++) {
+		copy[i] = sites[i];
+	}
+	sitesLock.clear(std::memory_order_release);
+
+	std::cout << "Allocation sites (return address of operator new, innermost AllocScope):\n";
+	for (int printed = 0; printed < maxSites; printed++) {
+		AllocSite *busiest = NULL;
+		for (int i = 0; i < ALLOC_SITES_MAX; i++) {
+			if (copy[i].allocations > 0 && (busiest == NULL || copy[i].allocations > busiest->allocations)) {
+				busiest = &copy[i];
+			}
+		}
+		if (busiest == NULL) {
+			break;
+		}
+		std::cout << std::setw(10) << busiest->allocations << " allocations " << std::setw(10) << busiest->bytes << " bytes  "
+			<< busiest->address << "  " << (busiest->scope[0] != '\0' ? busiest->scope : "(no scope)") << "\n";
+		busiest->allocations = 0;
+	}
+#else
+	(void)maxSites;
+#endif
+}
+
+void ResetAllocSites() {
+#ifdef ALLOC_SITES
+	while (sitesLock.test_and_set(std::memory_order_acquire)) {}
+	for (int i = 0; i < ALLOC_SITES_MAX; i++) {
+		sites[i].address = NULL;
+		sites[i].scope = NULL;
+		sites[i].allocations = 0;
+		sites[i].bytes = 0;
+	}
+	sitesLock.clear(std::memory_order_release);
+#endif
+}
+
+void RecordAllocSites(bool record) {
+#ifdef ALLOC_SITES
+	recordingSites = record;
+#else
+	(void)record;
+#endif
+}
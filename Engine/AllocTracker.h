@@ -0,0 +1,51 @@
+#pragma once
+
+// Counts heap allocations by replacing the global operator new and delete.
+// Linking AllocTracker.cpp is enough to count every allocation in the program; build with
+// NO_ALLOC_TRACKING to leave the allocator alone. The counters are atomic, so allocations on
+// job workers are counted too.
+//
+// AllocTracker.cpp is compiled into each game that wants it rather than into the engine
+// library, since a linker only takes an object out of a library for the symbols it is
+// missing, and the runtime's own operator new would win.
+//
+// Debug builds (or builds with ALLOC_SITES defined) also attribute every allocation to its
+// call site, the return address of operator new together with the innermost AllocScope
+// open on that thread, and PrintAllocSites() lists the busiest ones.
+
+#if defined(_DEBUG) && !defined(ALLOC_SITES)
+#define ALLOC_SITES
+#endif
+#define ALLOC_SITES_MAX 256		// Call sites kept, later ones are counted under the last slot
+
+struct AllocCounts {
+	long long allocations;
+	long long frees;
+	long long bytes;		// Bytes requested by the allocations
+};
+
+// Totals since the program started
+AllocCounts GetAllocCounts();
+// Counts between two calls of GetAllocCounts()
+AllocCounts AllocDelta(const AllocCounts &from, const AllocCounts &to);
+
+// Counts the allocations made while it is alive (on any thread), and names the scope call
+// sites are attributed to on this one. Scopes nest; the innermost name wins.
+class AllocScope {
+public:
+	explicit AllocScope(const char *name);
+	~AllocScope();
+	AllocCounts Counts() const;
+
+private:
+	const char *name;
+	const char *parent;
+	AllocCounts start;
+};
+
+// Prints the call sites with the most allocations since the last ResetAllocSites()
+// (only when built with ALLOC_SITES). Sites are recorded while RecordAllocSites() is on,
+// which it is from the start.
+void PrintAllocSites(int maxSites);
+void ResetAllocSites();
+void RecordAllocSites(bool record);
@@ -0,0 +1,249 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+Benchmark::Benchmark() {
+	active = false;
+	frame = 0;
+	warmupFrames = BENCHMARK_WARMUP_FRAMES;
+	measuredFrames = BENCHMARK_FRAMES;
+	threshold = BENCHMARK_THRESHOLD;
+	drawCalls = 0.0;
+	vertices = 0.0;
+	bytes = 0.0;
+	gpu = NULL;
+	for (int i = 0; i < GPU_TIMER_MAX_PASSES; i++) {
+		gpuPassMs[i] = 0.0;
+	}
+	gpuTotalMs = 0.0;
+	gpuFrames = 0;
+	frees = 0;
+	allocatedBytes = 0;
+	maxAllocations = -1;
+	frameAllocStart = GetAllocCounts();
+}
+
+bool Benchmark::ParseArguments(int argc, char *argv[]) {
+	for (int i = 1; i + 1 < argc; i++) {
+		std::string argument = argv[i];
+		if (argument == "--benchmark") {
+			active = true;
+			scenario = argv[++i];
+		} else if (argument == "--warmup") {
+			warmupFrames = std::max(atoi(argv[++i]), 0);
+		} else if (argument == "--frames") {
+			measuredFrames = std::max(atoi(argv[++i]), 1);
+		} else if (argument == "--out") {
+			outPrefix = argv[++i];
+		} else if (argument == "--baseline") {
+			baselinePath = argv[++i];
+		} else if (argument == "--threshold") {
+			threshold = (float)atof(argv[++i]);
+		} else if (argument == "--max-allocs") {
+			maxAllocations = std::max(atoi(argv[++i]), 0);
+		}
+	}
+	if (!active) {
+		return false;
+	}
+	if (outPrefix.empty()) {
+		outPrefix = "benchmark_" + scenario;
+	}
+	frameMs.reserve(measuredFrames);
+	tickMs.reserve(measuredFrames);
+	renderMs.reserve(measuredFrames);
+	swapMs.reserve(measuredFrames);
+	frameAllocations.reserve(measuredFrames);
+	std::cout << "Benchmark " << scenario << ": " << warmupFrames << " warm-up frames, " << measuredFrames << " measured\n";
+	return true;
+}
+
+void Benchmark::RecordFrame(const FrameProfiler &profiler, const GLStats &stats, const GPUTimer *gpu) {
+	AllocCounts now = GetAllocCounts();
+	AllocCounts allocations = AllocDelta(frameAllocStart, now);
+	frameAllocStart = now;
+	if (frame++ < warmupFrames) {
+		// Only the call sites of the measured frames are listed
+		if (frame == warmupFrames) {
+			ResetAllocSites();
+			RecordAllocSites(true);
+		}
+		return;
+	}
+	frameAllocations.push_back((int)allocations.allocations);
+	frees += allocations.frees;
+	allocatedBytes += allocations.bytes;
+	if (Done()) {
+		RecordAllocSites(false);	// Keep what reports and shutdown allocate out of the list
+	}
+	frameMs.push_back(profiler.FrameMs(0));
+	tickMs.push_back(profiler.PhaseMs(PHASE_UPDATE, 0));
+	renderMs.push_back(profiler.PhaseMs(PHASE_RENDER, 0));
+	swapMs.push_back(profiler.PhaseMs(PHASE_SWAP, 0));
+	drawCalls += stats.lastTotal.drawCalls;
+	vertices += stats.lastTotal.vertices;
+	bytes += stats.lastTotal.bytes;
+
+	// GPU results arrive GPU_TIMER_LATENCY frames late, which doesn't matter for averages
+	if (gpu != NULL && gpu->newResults) {
+		this->gpu = gpu;
+		for (int i = 0; i < gpu->passCount; i++) {
+			gpuPassMs[i] += gpu->lastMs[i];
+		}
+		gpuTotalMs += gpu->lastTotalMs;
+		gpuFrames++;
+	}
+}
+
+bool Benchmark::Done() const {
+	return frame >= warmupFrames + measuredFrames;
+}
+
+void Benchmark::AddMetric(const std::string &name, double value) {
+	metrics.push_back(std::make_pair(name, value));
+}
+
+float Benchmark::Percentile(std::vector<float> values, float percentile) {
+	if (values.empty()) {
+		return 0.0f;
+	}
+	size_t rank = std::min((size_t)(percentile / 100.0f * values.size()), values.size() - 1);
+	std::nth_element(values.begin(), values.begin() + rank, values.end());
+	return values[rank];
+}
+
+int Benchmark::Finish(const char *game) {
+	int frames = (int)frameMs.size();
+	if (frames == 0) {
+		std::cout << "Benchmark " << scenario << " ended before any frame was measured\n";
+		return 1;
+	}
+
+	// Game-specific metrics were added while running, the common ones go first
+	std::vector<std::pair<std::string, double>> extra;
+	extra.swap(metrics);
+	AddMetric("frame_p50_ms", Percentile(frameMs, 50.0f));
+	AddMetric("frame_p95_ms", Percentile(frameMs, 95.0f));
+	AddMetric("frame_p99_ms", Percentile(frameMs, 99.0f));
+	AddMetric("frame_max_ms", *std::max_element(frameMs.begin(), frameMs.end()));
+	AddMetric("tick_p50_ms", Percentile(tickMs, 50.0f));
+	AddMetric("tick_p95_ms", Percentile(tickMs, 95.0f));
+	AddMetric("tick_p99_ms", Percentile(tickMs, 99.0f));
+	AddMetric("render_p50_ms", Percentile(renderMs, 50.0f));
+	AddMetric("render_p95_ms", Percentile(renderMs, 95.0f));
+	AddMetric("swap_p95_ms", Percentile(swapMs, 95.0f));
+	if (glStats.enabled) {
+		AddMetric("draw_calls_per_frame", drawCalls / frames);
+		AddMetric("vertices_per_frame", vertices / frames);
+		AddMetric("vertex_kb_per_frame", bytes / frames / 1024.0);
+	}
+	if (gpuFrames > 0) {
+		AddMetric("gpu_ms_per_frame", gpuTotalMs / gpuFrames);
+		for (int i = 0; i < gpu->passCount; i++) {
+			std::string name = gpu->passNames[i];
+			for (size_t c = 0; c < name.size(); c++) {
+				name[c] = name[c] == ' ' ? '_' : (char)tolower(name[c]);
+			}
+			AddMetric("gpu_" + name + "_ms", gpuPassMs[i] / gpuFrames);
+		}
+		if (gpu->lateFrames > 0) {
+			std::cout << gpu->lateFrames << " frames of GPU timings weren't ready in time and were dropped\n";
+		}
+	}
+	long long allocations = 0;
+	int worstAllocations = 0;
+	int framesOverLimit = 0;
+	for (int i = 0; i < frames; i++) {
+		allocations += frameAllocations[i];
+		worstAllocations = std::max(worstAllocations, frameAllocations[i]);
+		if (maxAllocations >= 0 && frameAllocations[i] > maxAllocations) {
+			framesOverLimit++;
+		}
+	}
+	AddMetric("allocs_per_frame", (double)allocations / frames);
+	AddMetric("allocs_max_per_frame", worstAllocations);
+	AddMetric("frees_per_frame", (double)frees / frames);
+	AddMetric("alloc_kb_per_frame", allocatedBytes / 1024.0 / frames);
+	metrics.insert(metrics.end(), extra.begin(), extra.end());
+
+	std::ofstream json(outPrefix + ".json");
+	json << "{\n\t\"game\": \"" << game << "\",\n\t\"scenario\": \"" << scenario << "\",\n"
+		<< "\t\"warmup_frames\": " << warmupFrames << ",\n\t\"frames\": " << frames << ",\n\t\"metrics\": {\n";
+	for (size_t i = 0; i < metrics.size(); i++) {
+		json << "\t\t\"" << metrics[i].first << "\": " << metrics[i].second << (i + 1 < metrics.size() ? ",\n" : "\n");
+	}
+	json << "\t}\n}\n";
+
+	std::ofstream csv(outPrefix + ".csv");
+	csv << "game,scenario,metric,value\n";
+	for (size_t i = 0; i < metrics.size(); i++) {
+		csv << game << "," << scenario << "," << metrics[i].first << "," << metrics[i].second << "\n";
+	}
+
+	std::cout << game << " / " << scenario << " over " << frames << " frames:\n";
+	for (size_t i = 0; i < metrics.size(); i++) {
+		std::cout << "  " << metrics[i].first << " " << metrics[i].second << "\n";
+	}
+	std::cout << "Wrote " << outPrefix << ".json and " << outPrefix << ".csv\n";
+
+	int result = 0;
+	if (framesOverLimit > 0) {
+		std::cout << "ALLOCATIONS: " << framesOverLimit << " of " << frames << " frames made more than " << maxAllocations
+			<< " allocations (worst " << worstAllocations << ")\n";
+		PrintAllocSites(10);
+		result = 1;
+	}
+	else if (maxAllocations >= 0) {
+		std::cout << "No frame made more than " << maxAllocations << " allocations\n";
+	}
+	if (!baselinePath.empty() && !CompareWithBaseline(game)) {
+		result = 1;
+	}
+	return result;
+}
+
+// Every metric is lower-is-better. Metrics missing on either side are skipped, and so are
+// maximums, which one scheduler hiccup can move by milliseconds.
+bool Benchmark::CompareWithBaseline(const char *game) {
+	std::ifstream file(baselinePath);
+	if (!file) {
+		std::cout << "Unable to read baseline " << baselinePath << "\n";
+		return false;
+	}
+	std::string line;
+	std::getline(file, line);	// Header
+	int compared = 0;
+	int regressions = 0;
+	while (std::getline(file, line)) {
+		std::istringstream row(line);
+		std::string baselineGame, baselineScenario, name, value;
+		if (!std::getline(row, baselineGame, ',') || !std::getline(row, baselineScenario, ',') ||
+			!std::getline(row, name, ',') || !std::getline(row, value)) {
+			continue;
+		}
+		if (baselineGame != game || baselineScenario != scenario || name.find("_max") != std::string::npos) {
+			continue;
+		}
+		for (size_t i = 0; i < metrics.size(); i++) {
+			if (metrics[i].first != name) {
+				continue;
+			}
+			double baseline = atof(value.c_str());
+			double current = metrics[i].second;
+			bool isTime = name.size() > 3 && name.compare(name.size() - 3, 3, "_ms") == 0;
+			bool grew = current > baseline * (1.0 + threshold / 100.0);
+			if (grew && (!isTime || current - baseline > BENCHMARK_SLACK_MS)) {
+				std::cout << "REGRESSION " << name << ": " << current << " (baseline " << baseline << ")\n";
+				regressions++;
+			}
+			compared++;
+		}
+	}
+	std::cout << "Compared " << compared << " metrics with " << baselinePath << ": " << regressions
+		<< " over the " << threshold << "% threshold\n";
+	return regressions == 0;
+}
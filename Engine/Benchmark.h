@@ -0,0 +1,82 @@
+#pragma once
+
+#include "FrameProfiler.h"
+#include "GLStats.h"
+#include "GPUTimer.h"
+#include "AllocTracker.h"
+#include <string>
+#include <vector>
+#include <utility>
+
+#define BENCHMARK_WARMUP_FRAMES 120
+#define BENCHMARK_FRAMES 600
+#define BENCHMARK_THRESHOLD 10.0f	// Percent a metric may grow over the baseline before the run fails
+#define BENCHMARK_SLACK_MS 0.05f	// Timing changes smaller than this never fail a run
+#define BENCHMARK_SEED 1			// Session seed of every benchmark unless SEED is set
+
+// Runs a game through a scripted scenario for a fixed number of frames and reports
+// frame time percentiles, tick (update) time, GL call counts, heap allocations and, for a
+// game that passes its GPUTimer, the GPU time of each render pass.
+//
+//   <game> --benchmark <scenario> [--warmup N] [--frames N] [--out <prefix>]
+//          [--baseline <csv>] [--threshold <percent>] [--max-allocs N]
+//
+// The game opens a hidden window, runs uncapped and feeds its own scripted input, one
+// simulation tick per frame, so a scenario plays out the same on every machine.
+// Results go to <prefix>.json and <prefix>.csv (benchmark_<scenario> by default). Given a
+// baseline CSV from an earlier run, every metric that grew by more than the threshold is
+// printed and Finish() returns 1 so scripts can fail on regressions. With --max-allocs, so
+// does any measured frame that allocated more than N times (0 checks that the scenario's
+// steady state never touches the heap); the busiest call sites are listed in debug builds.
+class Benchmark {
+public:
+	Benchmark();
+
+	// Returns true if the arguments ask for a benchmark
+	bool ParseArguments(int argc, char *argv[]);
+
+	// Call once per frame after profiler.EndFrame() and glStats.EndFrame()
+	void RecordFrame(const FrameProfiler &profiler, const GLStats &stats, const GPUTimer *gpu = NULL);
+	bool Done() const;
+
+	// Adds a game-specific result (lower is better) to the report
+	void AddMetric(const std::string &name, double value);
+
+	// Writes the reports, compares them with the baseline and returns the exit code
+	int Finish(const char *game);
+
+	// Value below which the given percent of values fall (nearest rank), 0 if there are none
+	static float Percentile(std::vector<float> values, float percentile);
+
+	bool active;
+	std::string scenario;
+	int frame;				// Frames run so far, warm-up included
+	int warmupFrames;
+	int measuredFrames;
+
+private:
+	// Compares with the baseline rows of the same game and scenario
+	bool CompareWithBaseline(const char *game);
+
+	std::string outPrefix;
+	std::string baselinePath;
+	float threshold;
+
+	std::vector<float> frameMs;
+	std::vector<float> tickMs;
+	std::vector<float> renderMs;
+	std::vector<float> swapMs;
+	std::vector<int> frameAllocations;
+	AllocCounts frameAllocStart;	// Counts when the frame being run started
+	long long frees;
+	long long allocatedBytes;
+	int maxAllocations;			// Allowed per measured frame, -1 for no limit
+	double drawCalls;
+	double vertices;
+	double bytes;
+	const GPUTimer *gpu;
+	double gpuPassMs[GPU_TIMER_MAX_PASSES];	// Summed over the measured frames that got GPU results
+	double gpuTotalMs;
+	int gpuFrames;
+	std::vector<std::pair<std::string, double>> metrics;
+};
@@ -0,0 +1,195 @@
+#include "BoxOverlap.h"
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define BOX_OVERLAP_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// MSVC lets any function use any intrinsic; GCC and Clang need each function tagged
+#if defined(BOX_OVERLAP_X86) && defined(__GNUC__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define TARGET_AVX2
+#define TARGET_AVX512
+#endif
+
+static void OverlapBoxesScalar(float x, float y, float halfWidth, float halfHeight,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t count, unsigned int *mask) {
+	memset(mask, 0, BOX_MASK_WORDS(count) * sizeof(unsigned int));
+	for (size_t i = 0; i < count; i++) {
+		unsigned int hit = (boxX[i] + boxHalfWidth[i] >= x - halfWidth) & (boxX[i] - boxHalfWidth[i] <= x + halfWidth) &
+			(boxY[i] + boxHalfHeight[i] >= y - halfHeight) & (boxY[i] - boxHalfHeight[i] <= y + halfHeight);
+		mask[i >> 5] |= hit << (i & 31);
+	}
+}
+
+// The vector kernels finish the last count % width boxes with the scalar test.
+// Lane groups start at multiples of their width, so they never straddle a mask word.
+static void OverlapBoxesTail(float x, float y, float halfWidth, float halfHeight,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t start, size_t count, unsigned int *mask) {
+	for (size_t i = start; i < count; i++) {
+		unsigned int hit = (boxX[i] + boxHalfWidth[i] >= x - halfWidth) & (boxX[i] - boxHalfWidth[i] <= x + halfWidth) &
+			(boxY[i] + boxHalfHeight[i] >= y - halfHeight) & (boxY[i] - boxHalfHeight[i] <= y + halfHeight);
+		mask[i >> 5] |= hit << (i & 31);
+	}
+}
+
+#ifdef BOX_OVERLAP_X86
+static void OverlapBoxesSSE2(float x, float y, float halfWidth, float halfHeight,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t count, unsigned int *mask) {
+	memset(mask, 0, BOX_MASK_WORDS(count) * sizeof(unsigned int));
+	__m128 left = _mm_set1_ps(x - halfWidth);
+	__m128 right = _mm_set1_ps(x + halfWidth);
+	__m128 bottom = _mm_set1_ps(y - halfHeight);
+	__m128 top = _mm_set1_ps(y + halfHeight);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 bx = _mm_loadu_ps(boxX + i);
+		__m128 by = _mm_loadu_ps(boxY + i);
+		__m128 bw = _mm_loadu_ps(boxHalfWidth + i);
+		__m128 bh = _mm_loadu_ps(boxHalfHeight + i);
+		__m128 hit = _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(bx, bw), left), _mm_cmple_ps(_mm_sub_ps(bx, bw), right));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_add_ps(by, bh), bottom));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_sub_ps(by, bh), top));
+		mask[i >> 5] |= (unsigned int)_mm_movemask_ps(hit) << (i & 31);
+	}
+	OverlapBoxesTail(x, y, halfWidth, halfHeight, boxX, boxY, boxHalfWidth, boxHalfHeight, i, count, mask);
+}
+
+TARGET_AVX2 static void OverlapBoxesAVX2(float x, float y, float halfWidth, float halfHeight,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t count, unsigned int *mask) {
+	memset(mask, 0, BOX_MASK_WORDS(count) * sizeof(unsigned int));
+	__m256 left = _mm256_set1_ps(x - halfWidth);
+	__m256 right = _mm256_set1_ps(x + halfWidth);
+	__m256 bottom = _mm256_set1_ps(y - halfHeight);
+	__m256 top = _mm256_set1_ps(y + halfHeight);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 bx = _mm256_loadu_ps(boxX + i);
+		__m256 by = _mm256_loadu_ps(boxY + i);
+		__m256 bw = _mm256_loadu_ps(boxHalfWidth + i);
+		__m256 bh = _mm256_loadu_ps(boxHalfHeight + i);
+		__m256 hit = _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(bx, bw), left, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_sub_ps(bx, bw), right, _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(by, bh), bottom, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_sub_ps(by, bh), top, _CMP_LE_OQ));
+		mask[i >> 5] |= (unsigned int)_mm256_movemask_ps(hit) << (i & 31);
+	}
+	// Avoid the AVX-to-SSE transition penalty in the caller
+	_mm256_zeroupper();
+	OverlapBoxesTail(x, y, halfWidth, halfHeight, boxX, boxY, boxHalfWidth, boxHalfHeight, i, count, mask);
+}
+
+TARGET_AVX512 static void OverlapBoxesAVX512(float x, float y, float halfWidth, float halfHeight,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t count, unsigned int *mask) {
+	memset(mask, 0, BOX_MASK_WORDS(count) * sizeof(unsigned int));
+	__m512 left = _mm512_set1_ps(x - halfWidth);
+	__m512 right = _mm512_set1_ps(x + halfWidth);
+	__m512 bottom = _mm512_set1_ps(y - halfHeight);
+	__m512 top = _mm512_set1_ps(y + halfHeight);
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16) {
+		__m512 bx = _mm512_loadu_ps(boxX + i);
+		__m512 by = _mm512_loadu_ps(boxY + i);
+		__m512 bw = _mm512_loadu_ps(boxHalfWidth + i);
+		__m512 bh = _mm512_loadu_ps(boxHalfHeight + i);
+		__mmask16 hit = _mm512_cmp_ps_mask(_mm512_add_ps(bx, bw), left, _CMP_GE_OQ);
+		hit = _mm512_mask_cmp_ps_mask(hit, _mm512_sub_ps(bx, bw), right, _CMP_LE_OQ);
+		hit = _mm512_mask_cmp_ps_mask(hit, _mm512_add_ps(by, bh), bottom, _CMP_GE_OQ);
+		hit = _mm512_mask_cmp_ps_mask(hit, _mm512_sub_ps(by, bh), top, _CMP_LE_OQ);
+		mask[i >> 5] |= (unsigned int)hit << (i & 31);
+	}
+	_mm256_zeroupper();
+	OverlapBoxesTail(x, y, halfWidth, halfHeight, boxX, boxY, boxHalfWidth, boxHalfHeight, i, count, mask);
+}
+
+static void CpuId(int leaf, unsigned int regs[4]) {
+#ifdef _MSC_VER
+	int r[4];
+	__cpuidex(r, leaf, 0);
+	for (int i = 0; i < 4; i++) {
+		regs[i] = (unsigned int)r[i];
+	}
+#else
+	__cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Which register sets the OS saves on a context switch (XCR0)
+static unsigned long long OSEnabledState() {
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+#endif
+
+BoxOverlapFunction OverlapBoxes = OverlapBoxesScalar;
+static const char *boxOverlapPathName = "scalar";
+
+void InitBoxOverlap() {
+	OverlapBoxes = OverlapBoxesScalar;
+	boxOverlapPathName = "scalar";
+#ifdef BOX_OVERLAP_X86
+	unsigned int regs[4];
+	CpuId(0, regs);
+	unsigned int maxLeaf = regs[0];
+	CpuId(1, regs);
+	bool sse2 = (regs[3] & (1u << 26)) != 0;
+	bool osxsave = (regs[2] & (1u << 27)) != 0;
+	bool avx = (regs[2] & (1u << 28)) != 0;
+	bool avx2 = false;
+	bool avx512 = false;
+	if (osxsave && avx && maxLeaf >= 7) {
+		unsigned long long xcr0 = OSEnabledState();
+		CpuId(7, regs);
+		// XMM and YMM state for AVX2; opmask and ZMM state as well for AVX-512
+		avx2 = (xcr0 & 0x6) == 0x6 && (regs[1] & (1u << 5)) != 0;
+		avx512 = (xcr0 & 0xE6) == 0xE6 && (regs[1] & (1u << 16)) != 0;
+	}
+	if (avx512) {
+		OverlapBoxes = OverlapBoxesAVX512;
+		boxOverlapPathName = "AVX-512";
+	} else if (avx2) {
+		OverlapBoxes = OverlapBoxesAVX2;
+		boxOverlapPathName = "AVX2";
+	} else if (sse2) {
+		OverlapBoxes = OverlapBoxesSSE2;
+		boxOverlapPathName = "SSE2";
+	}
+#endif
+}
+
+const char *BoxOverlapPathName() {
+	return boxOverlapPathName;
+}
+
+int FirstHit(const unsigned int *mask, size_t count) {
+	size_t words = BOX_MASK_WORDS(count);
+	for (size_t w = 0; w < words; w++) {
+		unsigned int bits = mask[w];
+		if (bits != 0) {
+			int bit = 0;
+			while ((bits & 1u) == 0) {
+				bits >>= 1;
+				bit++;
+			}
+			return (int)(w * 32 + bit);
+		}
+	}
+	return -1;
+}
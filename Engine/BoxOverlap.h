@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+
+// Number of 32-bit mask words needed to hold one hit bit per box
+#define BOX_MASK_WORDS(count) (((count) + 31) / 32)
+
+// Tests one query box against count candidate boxes and sets bit i of mask when
+// candidate i overlaps the query. Boxes are centers plus half extents, stored as
+// separate arrays. Touching edges count as an overlap.
+typedef void (*BoxOverlapFunction)(float x, float y, float halfWidth, float halfHeight,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t count, unsigned int *mask);
+
+// Points at the scalar kernel until InitBoxOverlap() is called
+extern BoxOverlapFunction OverlapBoxes;
+
+// Picks the widest kernel the CPU and OS support: AVX-512 (16 boxes per instruction),
+// AVX2 (8), SSE2 (4) or scalar. Call once at startup.
+void InitBoxOverlap();
+const char *BoxOverlapPathName();
+
+// Returns the index of the lowest set bit in a mask of count bits, or -1 if none are set
+int FirstHit(const unsigned int *mask, size_t count);
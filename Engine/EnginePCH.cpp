@@ -0,0 +1 @@
+// Builds the precompiled header (EnginePCH.h is force-included)
@@ -0,0 +1,21 @@
+#pragma once
+
+// Precompiled header for the engine library and the games. Only headers nobody here edits
+// belong in it: the GL, SDL and GLM headers are most of what every file compiles, and a change
+// to anything in here rebuilds everything. The projects force-include it, so the sources don't
+// include it themselves and still build without precompiled headers.
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#include <SDL.h>
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
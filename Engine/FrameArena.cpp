@@ -0,0 +1,103 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+FrameArena frameArena;
+
+namespace {
+
+// Bytes to skip from at to the next multiple of alignment
+size_t alignmentPadding(const char *at, size_t alignment) {
+	return (alignment - (uintptr_t)at % alignment) % alignment;
+}
+
+}
+
+FrameArena::FrameArena() {
+	highWater = 0;
+	blockAllocations = 0;
+	frames = 0;
+	block = 0;
+	offset = 0;
+	usedBefore = 0;
+}
+
+FrameArena::~FrameArena() {
+	for (size_t i = 0; i < blocks.size(); i++) {
+		delete[] blocks[i].memory;
+	}
+}
+
+// Chains a block big enough for the allocation after the current one. Blocks only ever
+// follow the current one within a frame, Reset() merges them.
+void FrameArena::NextBlock(size_t bytes, size_t alignment) {
+	if (!blocks.empty()) {
+		usedBefore += blocks[block].size;
+		block = blocks.size();
+	}
+	Block next;
+	next.size = std::max((size_t)FRAME_ARENA_BLOCK_SIZE, bytes + alignment);
+	next.memory = new char[next.size];
+	blocks.push_back(next);
+	blockAllocations++;
+	offset = 0;
+}
+
+void *FrameArena::Allocate(size_t bytes, size_t alignment) {
+	if (blocks.empty() || offset + alignmentPadding(blocks[block].memory + offset, alignment) + bytes > blocks[block].size) {
+		NextBlock(bytes, alignment);
+	}
+	char *memory = blocks[block].memory + offset;
+	memory += alignmentPadding(memory, alignment);
+	offset = memory + bytes - blocks[block].memory;
+	highWater = std::max(highWater, Used());
+	return memory;
+}
+
+void FrameArena::Free(void *memory, size_t bytes) {
+	if (memory != NULL && !blocks.empty() && (char *)memory + bytes == blocks[block].memory + offset) {
+		offset = (char *)memory - blocks[block].memory;
+	}
+}
+
+void FrameArena::Reset() {
+	frames++;
+	// A frame that needed several blocks gets them as one from now on
+	if (blocks.size() > 1) {
+		size_t size = Capacity();
+		for (size_t i = 0; i < blocks.size(); i++) {
+			delete[] blocks[i].memory;
+		}
+		blocks.clear();
+		Block merged;
+		merged.size = size;
+		merged.memory = new char[size];
+		blocks.push_back(merged);
+		blockAllocations++;
+	}
+	block = 0;
+	offset = 0;
+	usedBefore = 0;
+}
+
+size_t FrameArena::Used() const {
+	return usedBefore + offset;
+}
+
+size_t FrameArena::Capacity() const {
+	size_t capacity = 0;
+	for (size_t i = 0; i < blocks.size(); i++) {
+		capacity += blocks[i].size;
+	}
+	return capacity;
+}
+
+void FrameArena::PrintStats() const {
+	if (frames == 0) {
+		return;
+	}
+	std::cout << "Frame arena: high water " << highWater / 1024.0f << " KB"
+		<< ", " << Capacity() / 1024 << " KB in " << blocks.size() << (blocks.size() == 1 ? " block" : " blocks")
+		<< ", " << blockAllocations << " heap allocations over " << frames << " frames" << std::endl;
+}
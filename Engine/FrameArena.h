@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define FRAME_ARENA_BLOCK_SIZE (64 * 1024)	// Smallest block the arena allocates
+
+// Bump allocator for memory that only lives until the end of the frame: vertex arrays,
+// formatted strings, collision scratch. Allocating is a pointer bump in the current block,
+// freeing is a no-op (except for the newest allocation, which is given back, so a growing
+// vector reuses its tail), and Reset() at the top of each frame makes all of it free again.
+//
+// A frame that runs out of the current block moves on to the next one in the chain,
+// allocating it if there is none. Reset() merges a chain that grew into a single block as big
+// as all of them, so after the first frames at a new peak the arena serves every frame from
+// one block and never calls the heap. highWater is the most any frame used.
+//
+// The arena is not thread-safe: allocate on the main thread and hand jobs the pointers.
+class FrameArena {
+public:
+	FrameArena();
+	~FrameArena();
+
+	void *Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+	template <class T>
+	T *AllocateArray(size_t count) {
+		return (T *)Allocate(count * sizeof(T), alignof(T));
+	}
+	// Gives the memory back if it was the last allocation, otherwise it waits for Reset()
+	void Free(void *memory, size_t bytes);
+
+	// Call once at the top of every frame. Everything allocated before is gone.
+	void Reset();
+
+	size_t Used() const;		// Bytes allocated this frame, alignment padding and skipped block tails included
+	size_t Capacity() const;	// Bytes in all blocks
+	// Prints the high-water mark and how often the arena went to the heap
+	void PrintStats() const;
+
+	size_t highWater;
+	int blockAllocations;	// Blocks taken from the heap since the program started
+	long long frames;
+
+private:
+	struct Block {
+		char *memory;
+		size_t size;
+	};
+	void NextBlock(size_t bytes, size_t alignment);
+
+	std::vector<Block> blocks;
+	size_t block;		// Block allocations come from
+	size_t offset;		// First free byte in it
+	size_t usedBefore;	// Bytes of the blocks before it
+};
+
+extern FrameArena frameArena;
+
+// Hands out memory from a FrameArena (the global one by default) to standard containers.
+// A container using it must not outlive the frame it was filled in.
+template <class T>
+class ArenaAllocator {
+public:
+	typedef T value_type;
+
+	ArenaAllocator() : arena(&frameArena) {}
+	explicit ArenaAllocator(FrameArena &arena) : arena(&arena) {}
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+	T *allocate(size_t count) {
+		return arena->AllocateArray<T>(count);
+	}
+	void deallocate(T *memory, size_t count) {
+		arena->Free(memory, count * sizeof(T));
+	}
+
+	FrameArena *arena;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.arena == b.arena;
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.arena != b.arena;
+}
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> ArenaString;
+typedef std::basic_ostringstream<char, std::char_traits<char>, ArenaAllocator<char>> ArenaStringStream;
@@ -0,0 +1,117 @@
+#include "FramePacer.h"
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+
+void FramePacer::Setup(int defaultTarget) {
+	frequency = SDL_GetPerformanceFrequency();
+	frameStart = SDL_GetPerformanceCounter();
+	nextFrameStart = frameStart;
+	lastFrameMs = 0.0f;
+	lastJitterMs = 0.0f;
+
+	sleepSamples = 0;
+	sleepMeanMs = 1.0;
+	sleepM2 = 0.0;
+	sleepEstimateMs = 2.0;
+
+	frames = 0;
+	frameSumMs = 0.0;
+	jitterSumMs = 0.0;
+	maxJitterMs = 0.0f;
+
+	int requested = defaultTarget;
+	const char *setting = SDL_getenv("FRAME_RATE");
+	if (setting != NULL) {
+		std::string value = setting;
+		if (value == "uncapped") {
+			requested = FRAME_PACER_UNCAPPED;
+		} else if (value == "vsync") {
+			requested = FRAME_PACER_VSYNC;
+		} else if (atoi(value.c_str()) > 0) {
+			requested = atoi(value.c_str());
+		}
+	}
+	SetTarget(requested);
+}
+
+void FramePacer::SetTarget(int target) {
+	this->target = target;
+	ticksPerFrame = target > 0 ? frequency / target : 0;
+	SDL_GL_SetSwapInterval(target == FRAME_PACER_VSYNC ? 1 : 0);
+	nextFrameStart = SDL_GetPerformanceCounter();
+}
+
+float FramePacer::BeginFrame() {
+	Uint64 now = SDL_GetPerformanceCounter();
+	float elapsed = (float)((double)(now - frameStart) / (double)frequency);
+	frameStart = now;
+
+	float frameMs = elapsed * 1000.0f;
+	if (target > 0) {
+		lastJitterMs = fabsf(frameMs - 1000.0f / target);
+	} else {
+		lastJitterMs = fabsf(frameMs - lastFrameMs);
+	}
+	lastFrameMs = frameMs;
+
+	// The first call measures setup time rather than a frame, so it is left out of the statistics
+	frames++;
+	if (frames > 1) {
+		frameSumMs += frameMs;
+		jitterSumMs += lastJitterMs;
+		if (lastJitterMs > maxJitterMs) {
+			maxJitterMs = lastJitterMs;
+		}
+	}
+	return elapsed;
+}
+
+void FramePacer::EndFrame() {
+	if (target <= 0) {
+		// Uncapped, or SDL_GL_SwapWindow already waited for the vertical blank
+		return;
+	}
+	nextFrameStart += ticksPerFrame;
+	Uint64 now = SDL_GetPerformanceCounter();
+	if (now >= nextFrameStart) {
+		// Running behind: start the next frame right away instead of rushing several to catch up
+		if (now - nextFrameStart > ticksPerFrame) {
+			nextFrameStart = now;
+		}
+		return;
+	}
+
+	// Sleep in 1 ms steps while the remaining time is longer than a typical SDL_Delay(1).
+	// Each sleep updates the estimate (mean plus one standard deviation) so the spin stays short.
+	double remainingMs = (double)(nextFrameStart - now) * 1000.0 / (double)frequency;
+	while (remainingMs > sleepEstimateMs) {
+		Uint64 sleepStart = SDL_GetPerformanceCounter();
+		SDL_Delay(1);
+		double sleptMs = (double)(SDL_GetPerformanceCounter() - sleepStart) * 1000.0 / (double)frequency;
+		remainingMs -= sleptMs;
+
+		sleepSamples++;
+		double delta = sleptMs - sleepMeanMs;
+		sleepMeanMs += delta / sleepSamples;
+		sleepM2 += delta * (sleptMs - sleepMeanMs);
+		double deviation = sleepSamples > 1 ? sqrt(sleepM2 / (sleepSamples - 1)) : 0.0;
+		sleepEstimateMs = sleepMeanMs + deviation;
+	}
+
+	// Spin for the rest
+	while (SDL_GetPerformanceCounter() < nextFrameStart) {
+	}
+}
+
+void FramePacer::PrintStats() {
+	int measured = frames - 1;
+	if (measured <= 0) {
+		return;
+	}
+	std::cout << "Frames: " << measured
+		<< ", average frame: " << frameSumMs / measured << " ms"
+		<< ", average jitter: " << jitterSumMs / measured << " ms"
+		<< ", max jitter: " << maxJitterMs << " ms" << std::endl;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL.h>
+
+// Targets accepted by FramePacer::SetTarget() besides a frame rate
+#define FRAME_PACER_UNCAPPED 0
+#define FRAME_PACER_VSYNC -1
+
+// Paces the main loop to a target frame rate without keeping a core busy.
+// Most of the time left in a frame is slept away with SDL_Delay and only the last
+// part (about one SDL_Delay overshoot) is spin-waited on the performance counter.
+class FramePacer {
+public:
+	// Reads the target from the FRAME_RATE environment variable ("60", "120", "uncapped" or "vsync")
+	// and falls back to defaultTarget. Call after the GL context is created so vsync can be set.
+	void Setup(int defaultTarget);
+	void SetTarget(int target);
+
+	// Call at the top of every frame. Returns the seconds since the previous call.
+	float BeginFrame();
+
+	// Call after SDL_GL_SwapWindow(). Waits until the next frame is due.
+	void EndFrame();
+
+	// Prints frame time and jitter statistics collected since Setup()
+	void PrintStats();
+
+	int target;
+	float lastFrameMs;		// Start-to-start time of the last frame
+	float lastJitterMs;		// Distance of the last frame from the target frame time (or from the frame before when not capped)
+
+private:
+	Uint64 frequency;
+	Uint64 ticksPerFrame;
+	Uint64 frameStart;
+	Uint64 nextFrameStart;
+
+	// Running estimate of how long SDL_Delay(1) really takes
+	int sleepSamples;
+	double sleepMeanMs;
+	double sleepM2;
+	double sleepEstimateMs;
+
+	int frames;
+	double frameSumMs;
+	double jitterSumMs;
+	float maxJitterMs;
+};
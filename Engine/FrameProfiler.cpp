@@ -0,0 +1,72 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <iostream>
+
+const char *PROFILER_PHASE_NAMES[NUM_PHASES + 1] = { "Events", "Update", "Render", "Swap", "Frame" };
+
+FrameProfiler::FrameProfiler() {
+	frequency = SDL_GetPerformanceFrequency();
+	phaseStart = 0;
+	next = 0;
+	count = 0;
+	for (int phase = 0; phase < NUM_PHASES; phase++) {
+		current[phase] = 0.0f;
+	}
+}
+
+void FrameProfiler::BeginFrame() {
+	phaseStart = SDL_GetPerformanceCounter();
+}
+
+void FrameProfiler::EndPhase(int phase) {
+	Uint64 now = SDL_GetPerformanceCounter();
+	current[phase] += (float)((double)(now - phaseStart) * 1000.0 / frequency);
+	phaseStart = now;
+}
+
+void FrameProfiler::EndFrame() {
+	float total = 0.0f;
+	for (int phase = 0; phase < NUM_PHASES; phase++) {
+		history[phase][next] = current[phase];
+		total += current[phase];
+		current[phase] = 0.0f;
+	}
+	history[NUM_PHASES][next] = total;
+	next = (next + 1) % PROFILER_HISTORY;
+	count = std::min(count + 1, PROFILER_HISTORY);
+}
+
+int FrameProfiler::FrameCount() const {
+	return count;
+}
+
+float FrameProfiler::PhaseMs(int phase, int age) const {
+	return history[phase][(next - 1 - age + 2 * PROFILER_HISTORY) % PROFILER_HISTORY];
+}
+
+float FrameProfiler::FrameMs(int age) const {
+	return PhaseMs(NUM_PHASES, age);
+}
+
+float FrameProfiler::Percentile(int phase, float percentile) {
+	if (count == 0) {
+		return 0.0f;
+	}
+	// The ring is only full after PROFILER_HISTORY frames, before that it starts at slot 0
+	std::copy(history[phase], history[phase] + count, sorted);
+	int rank = std::min((int)(percentile / 100.0f * count), count - 1);
+	std::nth_element(sorted, sorted + rank, sorted + count);
+	return sorted[rank];
+}
+
+void FrameProfiler::PrintStats() {
+	if (count == 0) {
+		return;
+	}
+	std::cout << "Last " << count << " frames (p50/p95/p99 ms):";
+	for (int phase = 0; phase <= NUM_PHASES; phase++) {
+		std::cout << " " << PROFILER_PHASE_NAMES[phase] << " " << Percentile(phase, 50.0f) << "/"
+			<< Percentile(phase, 95.0f) << "/" << Percentile(phase, 99.0f);
+	}
+	std::cout << std::endl;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL.h>
+
+#define PROFILER_HISTORY 300	// Frames kept for the percentiles and the graph
+
+// Parts of a frame, in the order the main loop runs them
+enum ProfilerPhase { PHASE_EVENTS, PHASE_UPDATE, PHASE_RENDER, PHASE_SWAP, NUM_PHASES };
+
+// Times each phase of the main loop with SDL_GetPerformanceCounter() and keeps the last
+// PROFILER_HISTORY frames in a ring. Recording costs one counter read per phase,
+// so it can stay on in release builds; the percentiles are only sorted when asked for.
+class FrameProfiler {
+public:
+	FrameProfiler();
+
+	// Call at the top of every frame, then EndPhase() after each phase in order and EndFrame()
+	// once the frame is presented. Phases a frame skipped count as 0.
+	void BeginFrame();
+	void EndPhase(int phase);
+	void EndFrame();
+
+	int FrameCount() const;	// Frames in the history, up to PROFILER_HISTORY
+	// Milliseconds spent in a phase, age frames ago (0 is the last finished frame)
+	float PhaseMs(int phase, int age) const;
+	float FrameMs(int age) const;
+	// Percentile (0 to 100) of a phase over the history, or of the whole frame for NUM_PHASES
+	float Percentile(int phase, float percentile);
+
+	// Prints p50/p95/p99 of every phase
+	void PrintStats();
+
+private:
+	Uint64 frequency;
+	Uint64 phaseStart;
+	float current[NUM_PHASES];
+	float history[NUM_PHASES + 1][PROFILER_HISTORY];	// The last row is the whole frame
+	float sorted[PROFILER_HISTORY];
+	int next;		// Slot the next finished frame goes to
+	int count;
+};
+
+extern const char *PROFILER_PHASE_NAMES[NUM_PHASES + 1];
@@ -0,0 +1,120 @@
+#include "GLStats.h"
+#include <SDL.h>
+#include <cstring>
+#include <iostream>
+
+GLStats glStats;
+
+GLStats::GLStats() {
+#ifdef GL_STATS
+	enabled = true;
+#else
+	enabled = false;
+#endif
+	passCount = 0;
+	memset(passes, 0, sizeof(passes));
+	memset(last, 0, sizeof(last));
+	memset(&lastTotal, 0, sizeof(lastTotal));
+	memset(attribBytes, 0, sizeof(attribBytes));
+	enabledAttribs = 0;
+	frame = 0;
+	BeginPass("Other");
+}
+
+void GLStats::Setup() {
+	if (SDL_getenv("GL_STATS") != NULL) {
+		enabled = true;
+	}
+	const char *csvPath = SDL_getenv("GL_STATS_CSV");
+	if (csvPath != NULL) {
+		enabled = true;
+		csv.open(csvPath);
+		if (!csv) {
+			std::cout << "Unable to write GL stats to " << csvPath << "\n";
+		}
+		csv << "frame,pass,draw_calls,vertices,bytes,texture_binds,program_binds,uniforms,attrib_pointers\n";
+	}
+	if (enabled) {
+		std::cout << "Counting GL calls\n";
+	}
+}
+
+void GLStats::BeginPass(const char *name) {
+	for (int i = 0; i < passCount; i++) {
+		if (strcmp(passNames[i], name) == 0) {
+			current = &passes[i];
+			return;
+		}
+	}
+	// Past the limit everything new is counted under the last pass
+	if (passCount == GL_STATS_MAX_PASSES) {
+		current = &passes[passCount - 1];
+		return;
+	}
+	passNames[passCount] = name;
+	current = &passes[passCount];
+	passCount++;
+}
+
+void GLStats::EndFrame() {
+	if (!enabled) {
+		return;
+	}
+	memset(&lastTotal, 0, sizeof(lastTotal));
+	for (int i = 0; i < passCount; i++) {
+		const GLCounts &counts = passes[i];
+		lastTotal.drawCalls += counts.drawCalls;
+		lastTotal.vertices += counts.vertices;
+		lastTotal.bytes += counts.bytes;
+		lastTotal.textureBinds += counts.textureBinds;
+		lastTotal.programBinds += counts.programBinds;
+		lastTotal.uniforms += counts.uniforms;
+		lastTotal.attribPointers += counts.attribPointers;
+
+		// Passes that did nothing this frame are left out of the CSV
+		if (csv.is_open() && (counts.drawCalls || counts.bytes || counts.textureBinds || counts.programBinds || counts.uniforms || counts.attribPointers)) {
+			csv << frame << "," << passNames[i] << "," << counts.drawCalls << "," << counts.vertices << "," << counts.bytes << ","
+				<< counts.textureBinds << "," << counts.programBinds << "," << counts.uniforms << "," << counts.attribPointers << "\n";
+		}
+	}
+	memcpy(last, passes, sizeof(passes));
+	memset(passes, 0, sizeof(passes));
+	BeginPass("Other");
+	frame++;
+}
+
+// Vertex arrays live in client memory, so every draw copies count vertices of each enabled array
+void GLStats::DrawArrays(GLsizei count) {
+	current->drawCalls++;
+	current->vertices += count;
+	for (int i = 0; i < GL_STATS_MAX_ATTRIBS; i++) {
+		if (enabledAttribs & (1u << i)) {
+			current->bytes += (long long)count * attribBytes[i];
+		}
+	}
+}
+
+void GLStats::VertexAttribPointer(GLuint index, GLint size, GLenum type, GLsizei stride) {
+	current->attribPointers++;
+	if (index >= GL_STATS_MAX_ATTRIBS) {
+		return;
+	}
+	int componentBytes = 4;
+	if (type == GL_UNSIGNED_BYTE || type == GL_BYTE) {
+		componentBytes = 1;
+	} else if (type == GL_UNSIGNED_SHORT || type == GL_SHORT) {
+		componentBytes = 2;
+	}
+	attribBytes[index] = stride != 0 ? stride : size * componentBytes;
+}
+
+void GLStats::EnableAttrib(GLuint index, bool enable) {
+	if (index >= GL_STATS_MAX_ATTRIBS) {
+		return;
+	}
+	if (enable) {
+		enabledAttribs |= 1u << index;
+	} else {
+		enabledAttribs &= ~(1u << index);
+	}
+}
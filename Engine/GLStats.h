@@ -0,0 +1,125 @@
+#pragma once
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <fstream>
+
+// Counts the GL calls a frame makes, split into named render passes.
+// Include this after the GL headers in every file that draws: the GL functions the games use
+// are redirected through the counting wrappers at the bottom of this file.
+// Counting is on when the game is built with GL_STATS defined or when the GL_STATS environment
+// variable is set, and GL_STATS_CSV=<file> also writes one row per pass per frame.
+// Build with NO_GL_STATS to leave the GL calls untouched.
+
+#define GL_STATS_MAX_PASSES 16
+#define GL_STATS_MAX_ATTRIBS 16
+
+struct GLCounts {
+	int drawCalls;
+	int vertices;
+	long long bytes;		// Client-side vertex data read by draws plus texture uploads and uniforms
+	int textureBinds;
+	int programBinds;
+	int uniforms;
+	int attribPointers;
+};
+
+class GLStats {
+public:
+	GLStats();
+	// Reads GL_STATS and GL_STATS_CSV
+	void Setup();
+
+	// Calls from here until the next BeginPass() are counted under name (a string literal)
+	void BeginPass(const char *name);
+	// Call after SDL_GL_SwapWindow(). Moves this frame's counts to last and writes the CSV rows.
+	void EndFrame();
+
+	// Called by the wrappers
+	void DrawArrays(GLsizei count);
+	void BindTexture() { current->textureBinds++; }
+	void UseProgram() { current->programBinds++; }
+	void Uniform(int bytes) { current->uniforms++; current->bytes += bytes; }
+	void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLsizei stride);
+	void EnableAttrib(GLuint index, bool enable);
+	void TexImage(GLsizei width, GLsizei height) { current->bytes += (long long)width * height * 4; }
+
+	bool enabled;
+	int passCount;
+	const char *passNames[GL_STATS_MAX_PASSES];
+	GLCounts last[GL_STATS_MAX_PASSES];		// Counts of the last finished frame, per pass
+	GLCounts lastTotal;
+
+private:
+	GLCounts passes[GL_STATS_MAX_PASSES];
+	GLCounts *current;
+	int attribBytes[GL_STATS_MAX_ATTRIBS];	// Bytes per vertex of each attribute array
+	unsigned int enabledAttribs;
+	long long frame;
+	std::ofstream csv;
+};
+
+extern GLStats glStats;
+
+#ifndef NO_GL_STATS
+// The wrappers are defined before the names are redirected, so they call the real functions
+// (or GLEW's function pointers on Windows)
+inline void CountedDrawArrays(GLenum mode, GLint first, GLsizei count) {
+	if (glStats.enabled) glStats.DrawArrays(count);
+	glDrawArrays(mode, first, count);
+}
+inline void CountedBindTexture(GLenum target, GLuint texture) {
+	if (glStats.enabled) glStats.BindTexture();
+	glBindTexture(target, texture);
+}
+inline void CountedUseProgram(GLuint program) {
+	if (glStats.enabled) glStats.UseProgram();
+	glUseProgram(program);
+}
+inline void CountedUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+	if (glStats.enabled) glStats.Uniform(16);
+	glUniform4f(location, v0, v1, v2, v3);
+}
+inline void CountedUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	if (glStats.enabled) glStats.Uniform(64 * count);
+	glUniformMatrix4fv(location, count, transpose, value);
+}
+inline void CountedVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+	if (glStats.enabled) glStats.VertexAttribPointer(index, size, type, stride);
+	glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+inline void CountedEnableVertexAttribArray(GLuint index) {
+	if (glStats.enabled) glStats.EnableAttrib(index, true);
+	glEnableVertexAttribArray(index);
+}
+inline void CountedDisableVertexAttribArray(GLuint index) {
+	if (glStats.enabled) glStats.EnableAttrib(index, false);
+	glDisableVertexAttribArray(index);
+}
+inline void CountedTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels) {
+	if (glStats.enabled) glStats.TexImage(width, height);
+	glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+}
+
+#undef glDrawArrays
+#undef glBindTexture
+#undef glUseProgram
+#undef glUniform4f
+#undef glUniformMatrix4fv
+#undef glVertexAttribPointer
+#undef glEnableVertexAttribArray
+#undef glDisableVertexAttribArray
+#undef glTexImage2D
+#define glDrawArrays CountedDrawArrays
+#define glBindTexture CountedBindTexture
+#define glUseProgram CountedUseProgram
+#define glUniform4f CountedUniform4f
+#define glUniformMatrix4fv CountedUniformMatrix4fv
+#define glVertexAttribPointer CountedVertexAttribPointer
+#define glEnableVertexAttribArray CountedEnableVertexAttribArray
+#define glDisableVertexAttribArray CountedDisableVertexAttribArray
+#define glTexImage2D CountedTexImage2D
+#endif
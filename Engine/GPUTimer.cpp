@@ -0,0 +1,161 @@
+#include "GPUTimer.h"
+#include <cstring>
+#include <string>
+#include <iostream>
+
+GPUTimer gpuTimer;
+
+GPUTimer::GPUTimer() {
+	enabled = false;
+	available = false;
+	synchronous = false;
+	passCount = 0;
+	memset(lastMs, 0, sizeof(lastMs));
+	lastTotalMs = 0.0f;
+	lastFrame = -1;
+	newResults = false;
+	lateFrames = 0;
+	memset(queries, 0, sizeof(queries));
+	memset(queryCounts, 0, sizeof(queryCounts));
+	memset(setFrames, 0, sizeof(setFrames));
+	set = 0;
+	open = false;
+	frame = 0;
+	passStart = 0;
+	openPass = 0;
+	memset(frameMs, 0, sizeof(frameMs));
+}
+
+void GPUTimer::Setup() {
+	const char *setting = SDL_getenv("GPU_TIMER");
+	if (setting != NULL) {
+		enabled = true;
+	}
+	const char *renderer = (const char *)glGetString(GL_RENDERER);
+	std::string rendererName = renderer != NULL ? renderer : "";
+	synchronous = (setting != NULL && std::string(setting) == "finish") ||
+		rendererName.find("llvmpipe") != std::string::npos || rendererName.find("softpipe") != std::string::npos;
+	if (synchronous) {
+		available = true;
+		if (enabled) {
+			std::cout << "Timing render passes with glFinish() on " << rendererName << "\n";
+		}
+		return;
+	}
+
+	available = SDL_GL_ExtensionSupported("GL_ARB_timer_query") == SDL_TRUE;
+	if (!available) {
+		if (enabled) {
+			std::cout << "GPU timer queries aren't supported, render passes won't be timed on the GPU\n";
+		}
+		return;
+	}
+	glGenQueries(GPU_TIMER_LATENCY * GPU_TIMER_MAX_QUERIES, &queries[0][0]);
+	if (enabled) {
+		std::cout << "Timing render passes on the GPU\n";
+	}
+}
+
+int GPUTimer::FindPass(const char *name) {
+	for (int i = 0; i < passCount; i++) {
+		if (strcmp(passNames[i], name) == 0) {
+			return i;
+		}
+	}
+	// Past the limit everything new is timed under the last pass
+	if (passCount == GPU_TIMER_MAX_PASSES) {
+		return passCount - 1;
+	}
+	passNames[passCount] = name;
+	return passCount++;
+}
+
+// Closes the running query, or finishes the running synchronous pass
+void GPUTimer::FinishPass() {
+	if (!open) {
+		return;
+	}
+	open = false;
+	if (synchronous) {
+		glFinish();
+		frameMs[openPass] += (SDL_GetPerformanceCounter() - passStart) * 1000.0f / SDL_GetPerformanceFrequency();
+		return;
+	}
+	glEndQuery(GL_TIME_ELAPSED);
+}
+
+void GPUTimer::BeginPass(const char *name) {
+	if (!enabled || !available) {
+		return;
+	}
+	if (synchronous) {
+		// The first pass of a frame starts once whatever came before it is done
+		if (open) {
+			FinishPass();
+		}
+		else {
+			glFinish();
+		}
+		openPass = FindPass(name);
+		passStart = SDL_GetPerformanceCounter();
+		open = true;
+		return;
+	}
+
+	FinishPass();
+	int &count = queryCounts[set];
+	if (count == GPU_TIMER_MAX_QUERIES) {
+		return;
+	}
+	queryPasses[set][count] = FindPass(name);
+	glBeginQuery(GL_TIME_ELAPSED, queries[set][count]);
+	count++;
+	open = true;
+}
+
+void GPUTimer::EndFrame() {
+	newResults = false;
+	bool timed = open || queryCounts[set] > 0;
+	FinishPass();
+	setFrames[set] = frame;
+	frame++;
+
+	// Synchronous timings are complete as soon as the frame is
+	if (synchronous) {
+		if (timed) {
+			lastTotalMs = 0.0f;
+			for (int i = 0; i < GPU_TIMER_MAX_PASSES; i++) {
+				lastMs[i] = frameMs[i];
+				lastTotalMs += frameMs[i];
+			}
+			memset(frameMs, 0, sizeof(frameMs));
+			lastFrame = frame - 1;
+			newResults = true;
+		}
+		return;
+	}
+
+	// The set the next frame reuses is the oldest one in flight
+	set = (set + 1) % GPU_TIMER_LATENCY;
+	int count = queryCounts[set];
+	if (count == 0) {
+		return;
+	}
+	queryCounts[set] = 0;
+	GLint ready = 0;
+	glGetQueryObjectiv(queries[set][count - 1], GL_QUERY_RESULT_AVAILABLE, &ready);
+	if (!ready) {
+		lateFrames++;
+		return;
+	}
+	memset(lastMs, 0, sizeof(lastMs));
+	lastTotalMs = 0.0f;
+	for (int i = 0; i < count; i++) {
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(queries[set][i], GL_QUERY_RESULT, &nanoseconds);
+		lastMs[queryPasses[set][i]] += nanoseconds / 1000000.0f;
+		lastTotalMs += nanoseconds / 1000000.0f;
+	}
+	lastFrame = setFrames[set];
+	newResults = true;
+}
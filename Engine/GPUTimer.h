@@ -0,0 +1,72 @@
+#pragma once
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+#define GPU_TIMER_MAX_PASSES 8
+#define GPU_TIMER_MAX_QUERIES 32	// Per frame; a pass begun several times in a frame uses a query each time
+#define GPU_TIMER_LATENCY 4			// Frames of queries in flight, results are read this many frames late
+
+// Times render passes on the GPU with GL_TIME_ELAPSED queries (ARB_timer_query).
+// BeginPass() closes the running query and opens one for the named pass, so passes cover
+// everything drawn between them, and EndFrame() closes the last one. Each frame uses its own
+// set of queries from a ring of GPU_TIMER_LATENCY, and a set is read back only when it comes
+// round again, by which time the GPU has long finished it, so reading never stalls the CPU.
+// A set whose results still aren't there is dropped and counted in lateFrames.
+//
+// Software renderers such as Mesa's llvmpipe rasterize when the frame is flushed, and their
+// timer queries only see the draw calls being queued, not the fill that dominates there. On
+// those the timer finishes the GL work at every pass boundary instead (synchronous) and times
+// the passes on the CPU. The stalls cost little there, the rasterizer runs on the CPU either
+// way. GPU_TIMER=finish forces this on any driver.
+//
+// Timing is on when enabled is set or the GPU_TIMER environment variable is, and the context
+// supports timer queries (or the timing is synchronous).
+class GPUTimer {
+public:
+	GPUTimer();
+	// Call once the GL context is current
+	void Setup();
+
+	// Times the GPU work from here until the next BeginPass() or EndFrame() under name (a string
+	// literal). A pass can be begun several times a frame, its times are added up.
+	void BeginPass(const char *name);
+	// Call after the last draw and before SDL_GL_SwapWindow(), so the swap isn't timed with the last pass
+	void EndFrame();
+
+	bool enabled;
+	bool available;			// The context supports timer queries, or synchronous is set
+	bool synchronous;		// Passes are timed on the CPU with glFinish()
+	int passCount;
+	const char *passNames[GPU_TIMER_MAX_PASSES];
+	float lastMs[GPU_TIMER_MAX_PASSES];		// GPU time of each pass in the newest frame read back
+	float lastTotalMs;
+	long long lastFrame;	// Frame lastMs belongs to, -1 before the first results
+	bool newResults;		// lastMs was updated by the latest EndFrame()
+	int lateFrames;
+
+private:
+	int FindPass(const char *name);
+	void FinishPass();
+
+	GLuint queries[GPU_TIMER_LATENCY][GPU_TIMER_MAX_QUERIES];
+	int queryPasses[GPU_TIMER_LATENCY][GPU_TIMER_MAX_QUERIES];
+	int queryCounts[GPU_TIMER_LATENCY];
+	long long setFrames[GPU_TIMER_LATENCY];	// Frame each set was issued in
+	int set;				// Set the frame being drawn uses
+	bool open;				// A query is running, or a synchronous pass
+	long long frame;
+	Uint64 passStart;		// Synchronous timing
+	int openPass;
+	float frameMs[GPU_TIMER_MAX_PASSES];
+};
+
+extern GPUTimer gpuTimer;
@@ -0,0 +1,101 @@
+#include "InputQueue.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+InputQueue inputQueue;
+
+InputQueue::InputQueue() {
+	latencyEvents = 0;
+	latencySumMs = 0.0;
+	latencyMaxMs = 0.0f;
+	polled.reserve(INPUT_QUEUE_RESERVE);
+	pending.reserve(INPUT_QUEUE_RESERVE);
+	events.reserve(INPUT_QUEUE_RESERVE);
+	memset(held, 0, sizeof(held));
+	memset(pressed, 0, sizeof(pressed));
+}
+
+void InputQueue::Poll() {
+	polled.clear();
+	Uint64 now = SDL_GetPerformanceCounter();
+	Uint32 ticks = SDL_GetTicks();
+	Uint64 ticksPerMs = SDL_GetPerformanceFrequency() / 1000;
+	InputEvent input;
+	while (SDL_PollEvent(&input.event)) {
+		// SDL stamps events in milliseconds when they reach its queue, which may be well before now
+		Uint64 age = (Uint64)(ticks - std::min(input.event.common.timestamp, ticks)) * ticksPerMs;
+		input.time = now - std::min(age, now);
+		polled.push_back(input);
+		pending.push_back(input);
+	}
+}
+
+const std::vector<InputEvent> &InputQueue::Polled() const {
+	return polled;
+}
+
+void InputQueue::BeginTick() {
+	events.swap(pending);
+	pending.clear();
+
+	int numKeys = 0;
+	const Uint8 *keys = SDL_GetKeyboardState(&numKeys);
+	memcpy(held, keys, std::min(numKeys, (int)SDL_NUM_SCANCODES));
+	memset(pressed, 0, sizeof(pressed));
+
+	Uint64 now = SDL_GetPerformanceCounter();
+	float msPerTick = 1000.0f / SDL_GetPerformanceFrequency();
+	for (size_t i = 0; i < events.size(); i++) {
+		const SDL_Event &event = events[i].event;
+		if (event.type == SDL_KEYDOWN && event.key.keysym.scancode < SDL_NUM_SCANCODES) {
+			pressed[event.key.keysym.scancode] = 1;
+		}
+		if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP || event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEBUTTONUP) {
+			float latencyMs = (now - events[i].time) * msPerTick;
+			latencyEvents++;
+			latencySumMs += latencyMs;
+			latencyMaxMs = std::max(latencyMaxMs, latencyMs);
+		}
+	}
+}
+
+const std::vector<InputEvent> &InputQueue::Events() const {
+	return events;
+}
+
+bool InputQueue::Held(SDL_Scancode key) const {
+	return held[key] != 0;
+}
+
+bool InputQueue::Pressed(SDL_Scancode key) const {
+	return pressed[key] != 0;
+}
+
+bool InputQueue::Down(SDL_Scancode key) const {
+	return held[key] != 0 || pressed[key] != 0;
+}
+
+bool InputQueue::Clicked(int *x, int *y) const {
+	for (size_t i = 0; i < events.size(); i++) {
+		const SDL_Event &event = events[i].event;
+		if (event.type == SDL_MOUSEBUTTONDOWN) {
+			if (x != NULL) {
+				*x = event.button.x;
+			}
+			if (y != NULL) {
+				*y = event.button.y;
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+void InputQueue::PrintStats() const {
+	if (latencyEvents == 0) {
+		return;
+	}
+	std::cout << "Input: " << latencyEvents << " key and button events, latency to the tick that took them: average "
+		<< latencySumMs / latencyEvents << " ms, max " << latencyMaxMs << " ms" << std::endl;
+}
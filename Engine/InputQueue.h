@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+#define INPUT_QUEUE_RESERVE 256		// Events held without allocating, more make the queue grow
+
+// An SDL event and the performance counter when it arrived
+struct InputEvent {
+	SDL_Event event;
+	Uint64 time;
+};
+
+// Collects input so a simulation tick sees every event since the one before it.
+//
+// Poll() drains SDL once a frame and stamps each event with when it arrived (SDL's millisecond
+// timestamp, carried over to the performance counter). BeginTick() at the start of a tick hands
+// the tick everything polled since the last tick, whether the frames in between ran a tick or
+// not, and snapshots the keyboard. A key that went down and up again between two ticks still
+// shows as Pressed(), so no press is dropped and none waits longer than a tick.
+//
+// A screen that doesn't tick (a menu) calls BeginTick() once a frame instead. Events that
+// concern the whole program, such as quitting, can be read from Polled() every frame.
+//
+// The time from arrival to the tick that took each key and mouse button event is the input
+// latency, reported by PrintStats().
+class InputQueue {
+public:
+	InputQueue();
+
+	// Moves every pending SDL event into the queue. Call once at the top of every frame.
+	void Poll();
+	// Events the last Poll() found
+	const std::vector<InputEvent> &Polled() const;
+
+	// Takes the events queued since the last tick and snapshots the keyboard
+	void BeginTick();
+	// Events of the current tick, oldest first
+	const std::vector<InputEvent> &Events() const;
+	// Key was down when the tick began
+	bool Held(SDL_Scancode key) const;
+	// Key went down since the last tick. Key repeat counts, like the SDL_KEYDOWN events it comes from.
+	bool Pressed(SDL_Scancode key) const;
+	// Held or pressed, so a tap shorter than a tick still acts for one tick
+	bool Down(SDL_Scancode key) const;
+	// Window position of the first mouse button press this tick (x and y may be NULL), false if there was none
+	bool Clicked(int *x, int *y) const;
+
+	// Prints the input latency collected since the start
+	void PrintStats() const;
+
+	long long latencyEvents;
+	double latencySumMs;
+	float latencyMaxMs;
+
+private:
+	std::vector<InputEvent> polled;
+	std::vector<InputEvent> pending;	// Polled but not taken by a tick yet
+	std::vector<InputEvent> events;
+	Uint8 held[SDL_NUM_SCANCODES];
+	Uint8 pressed[SDL_NUM_SCANCODES];
+};
+
+extern InputQueue inputQueue;
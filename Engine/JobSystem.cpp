@@ -0,0 +1,141 @@
+#include "JobSystem.h"
+#include "Trace.h"
+#include <SDL.h>
+#include <iostream>
+#include <cstdlib>
+
+JobSystem::JobSystem() : workerCount(1), current(NULL), invoke(NULL), remaining(0), generation(0), quitting(false) {
+	queues = std::vector<Queue>(1);
+}
+
+JobSystem::~JobSystem() {
+	Shutdown();
+}
+
+void JobSystem::Setup(int defaultThreads) {
+	Shutdown();
+
+	int requested = defaultThreads;
+	const char *setting = SDL_getenv("JOB_THREADS");
+	if (setting != NULL && atoi(setting) >= 0) {
+		requested = atoi(setting);
+	}
+	if (requested <= 0) {
+		requested = (int)std::thread::hardware_concurrency();
+	}
+	workerCount = requested > 0 ? requested : 1;
+
+	queues = std::vector<Queue>(workerCount);
+	for (int worker = 0; worker < workerCount; worker++) {
+		queues[worker].front = 0;
+	}
+	quitting = false;
+	for (int worker = 1; worker < workerCount; worker++) {
+		threads.push_back(std::thread(&JobSystem::WorkerLoop, this, worker));
+	}
+	std::cout << "Job system running " << workerCount << " workers\n";
+}
+
+void JobSystem::Shutdown() {
+	{
+		std::lock_guard<std::mutex> guard(wakeLock);
+		quitting = true;
+	}
+	wake.notify_all();
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+	threads.clear();
+	workerCount = 1;
+}
+
+void JobSystem::Run(size_t count, size_t chunkSize, const void *function, Invoker invoke) {
+	if (count == 0) {
+		return;
+	}
+	if (workerCount == 1 || count <= chunkSize) {
+		invoke(function, 0, count, 0);
+		return;
+	}
+
+	// Deal the chunks out round-robin so every worker starts with its own share
+	current = function;
+	this->invoke = invoke;
+	size_t chunks = (count + chunkSize - 1) / chunkSize;
+	remaining = chunks;
+	for (size_t c = 0; c < chunks; c++) {
+		Range range = { c * chunkSize, c * chunkSize + chunkSize < count ? c * chunkSize + chunkSize : count };
+		Queue &queue = queues[c % workerCount];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		queue.ranges.push_back(range);
+	}
+	{
+		std::lock_guard<std::mutex> guard(wakeLock);
+		generation++;
+	}
+	wake.notify_all();
+
+	while (remaining > 0) {
+		if (!RunOne(0)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+// Runs one chunk from the worker's own queue or, failing that, one stolen from another worker
+bool JobSystem::RunOne(int worker) {
+	Range range;
+	bool found = false;
+	{
+		Queue &own = queues[worker];
+		std::lock_guard<std::mutex> guard(own.lock);
+		if (own.ranges.size() > own.front) {
+			range = own.ranges.back();
+			own.ranges.pop_back();
+			found = true;
+		}
+		// An empty queue starts over at the front of its storage
+		if (own.ranges.size() == own.front) {
+			own.ranges.clear();
+			own.front = 0;
+		}
+	}
+	for (int i = 1; i < workerCount && !found; i++) {
+		Queue &victim = queues[(worker + i) % workerCount];
+		std::lock_guard<std::mutex> guard(victim.lock);
+		if (victim.ranges.size() > victim.front) {
+			range = victim.ranges[victim.front++];
+			found = true;
+		}
+		if (victim.ranges.size() == victim.front) {
+			victim.ranges.clear();
+			victim.front = 0;
+		}
+	}
+	if (!found) {
+		return false;
+	}
+	{
+		TRACE_SCOPE("Job chunk");
+		invoke(current, range.begin, range.end, worker);
+	}
+	remaining--;
+	return true;
+}
+
+void JobSystem::WorkerLoop(int worker) {
+	TRACE_THREAD_NAME("Job worker " + std::to_string(worker));
+	unsigned int seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> guard(wakeLock);
+			wake.wait(guard, [&] { return quitting || generation != seen; });
+			if (quitting) {
+				return;
+			}
+			seen = generation;
+		}
+		while (RunOne(worker)) {
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A small work-stealing job system for splitting loops across cores.
+// ParallelFor() cuts a range into chunks and deals them out to per-worker queues.
+// Each worker takes chunks from the back of its own queue and, when it runs dry,
+// steals from the front of the others. The calling thread works as worker 0 and
+// returns once every chunk has run.
+//
+// Chunks may run in any order on any worker, so a job should only write to its own
+// elements or to per-worker buffers (indexed by the worker argument) that the caller
+// merges in a fixed order afterwards.
+//
+// The function is called through a pointer to the caller's copy and the chunk queues keep
+// their storage, so a ParallelFor() on a warm job system never allocates.
+class JobSystem {
+public:
+	JobSystem();
+	~JobSystem();
+
+	// Starts the worker threads. The JOB_THREADS environment variable overrides
+	// defaultThreads; 0 means one worker per hardware thread and 1 runs everything inline.
+	void Setup(int defaultThreads);
+	void Shutdown();
+
+	// Runs function(begin, end, worker) over [0, count) in chunks of chunkSize. Ranges no
+	// bigger than one chunk run inline on the calling thread.
+	template <typename Function>
+	void ParallelFor(size_t count, size_t chunkSize, const Function &function) {
+		Run(count, chunkSize, &function, &Invoke<Function>);
+	}
+
+	int WorkerCount() const { return workerCount; }
+
+private:
+	struct Range {
+		size_t begin;
+		size_t end;
+	};
+	struct Queue {
+		std::mutex lock;
+		std::vector<Range> ranges;	// The owner pops from the back, thieves take from front
+		size_t front;
+	};
+	typedef void (*Invoker)(const void *function, size_t begin, size_t end, int worker);
+
+	template <typename Function>
+	static void Invoke(const void *function, size_t begin, size_t end, int worker) {
+		(*(const Function *)function)(begin, end, worker);
+	}
+
+	void Run(size_t count, size_t chunkSize, const void *function, Invoker invoke);
+	bool RunOne(int worker);
+	void WorkerLoop(int worker);
+
+	int workerCount;
+	std::vector<Queue> queues;
+	std::vector<std::thread> threads;
+	const void *current;
+	Invoker invoke;
+	std::atomic<size_t> remaining;
+
+	std::mutex wakeLock;
+	std::condition_variable wake;
+	unsigned int generation;	// Bumped for every ParallelFor() so sleeping workers know there is work
+	bool quitting;
+};
@@ -0,0 +1,43 @@
+#include "MicroBenchmark.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+MicroBenchmark::MicroBenchmark() {
+	frequency = (double)SDL_GetPerformanceFrequency();
+	sink = 0.0;
+	std::cout << std::left << std::setw(32) << "Benchmark" << std::right << std::setw(8) << "Size"
+		<< std::setw(14) << "ns/op" << std::setw(22) << "Throughput" << std::setw(12) << "allocs/op" << "\n";
+}
+
+void MicroBenchmark::Report(const char *name, int size, double itemsPerOp, const char *unit, double nsPerOp, double allocationsPerOp) {
+	MicroBenchmarkResult result;
+	result.name = name;
+	result.size = size;
+	result.nsPerOp = nsPerOp;
+	result.itemsPerSecond = nsPerOp > 0.0 ? itemsPerOp * 1e9 / nsPerOp : 0.0;
+	result.allocationsPerOp = allocationsPerOp;
+	result.unit = unit;
+	results.push_back(result);
+
+	// Throughput in millions of items per second reads best across the sweeps
+	std::cout << std::left << std::setw(32) << name << std::right << std::setw(8) << size
+		<< std::fixed << std::setprecision(1) << std::setw(14) << nsPerOp
+		<< std::setprecision(2) << std::setw(12) << result.itemsPerSecond / 1e6 << " M " << std::left << std::setw(9) << (std::string(unit) + "/s")
+		<< std::right << std::setw(10) << allocationsPerOp << "\n";
+	std::cout.unsetf(std::ios::floatfield);
+}
+
+bool MicroBenchmark::WriteCsv(const char *path) const {
+	std::ofstream csv(path);
+	if (!csv) {
+		std::cout << "Unable to write " << path << "\n";
+		return false;
+	}
+	csv << "name,size,ns_per_op,items_per_second,allocs_per_op,unit\n";
+	for (size_t i = 0; i < results.size(); i++) {
+		const MicroBenchmarkResult &result = results[i];
+		csv << result.name << "," << result.size << "," << result.nsPerOp << "," << result.itemsPerSecond << "," << result.allocationsPerOp << "," << result.unit << "\n";
+	}
+	return true;
+}
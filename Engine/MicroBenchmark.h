@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL.h>
+#include "AllocTracker.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#define MICRO_BENCHMARK_BATCH_MS 20.0	// A timed batch runs the operation at least this long
+#define MICRO_BENCHMARK_BATCHES 5		// Batches per case, the median is reported
+
+struct MicroBenchmarkResult {
+	std::string name;
+	int size;
+	double nsPerOp;
+	double itemsPerSecond;
+	double allocationsPerOp;
+	std::string unit;
+};
+
+// Times small operations in isolation. Run() repeats an operation in batches long enough to
+// time with SDL_GetPerformanceCounter() and reports the median batch as nanoseconds per
+// operation and items per second, where an operation handles itemsPerOp items of unit
+// (characters, tiles, pixels...), along with the heap allocations per operation.
+// The operation returns a value computed from its work, which is summed into a sink so the
+// compiler can't throw the work away.
+class MicroBenchmark {
+public:
+	MicroBenchmark();
+
+	template <typename Operation>
+	void Run(const char *name, int size, double itemsPerOp, const char *unit, Operation operation);
+
+	// Writes name,size,ns_per_op,items_per_second,allocs_per_op,unit rows
+	bool WriteCsv(const char *path) const;
+
+	std::vector<MicroBenchmarkResult> results;
+
+private:
+	void Report(const char *name, int size, double itemsPerOp, const char *unit, double nsPerOp, double allocationsPerOp);
+
+	double frequency;
+	double sink;
+};
+
+template <typename Operation>
+void MicroBenchmark::Run(const char *name, int size, double itemsPerOp, const char *unit, Operation operation) {
+	// Warm the caches, then double the iterations until a batch is long enough to time
+	sink += (double)operation();
+	long long iterations = 1;
+	double batchMs = 0.0;
+	while (true) {
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (long long i = 0; i < iterations; i++) {
+			sink += (double)operation();
+		}
+		batchMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / frequency;
+		if (batchMs >= MICRO_BENCHMARK_BATCH_MS) {
+			break;
+		}
+		iterations *= 2;
+	}
+
+	double nsPerOp[MICRO_BENCHMARK_BATCHES];
+	AllocCounts allocStart = GetAllocCounts();
+	for (int batch = 0; batch < MICRO_BENCHMARK_BATCHES; batch++) {
+		Uint64 start = SDL_GetPerformanceCounter();
+		for (long long i = 0; i < iterations; i++) {
+			sink += (double)operation();
+		}
+		nsPerOp[batch] = (SDL_GetPerformanceCounter() - start) * 1e9 / frequency / iterations;
+	}
+	AllocCounts allocations = AllocDelta(allocStart, GetAllocCounts());
+	std::nth_element(nsPerOp, nsPerOp + MICRO_BENCHMARK_BATCHES / 2, nsPerOp + MICRO_BENCHMARK_BATCHES);
+	Report(name, size, itemsPerOp, unit, nsPerOp[MICRO_BENCHMARK_BATCHES / 2],
+		(double)allocations.allocations / (iterations * MICRO_BENCHMARK_BATCHES));
+}
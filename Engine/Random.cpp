@@ -0,0 +1,69 @@
+#include "Random.h"
+#include <SDL.h>
+#include <iostream>
+#include <cstdlib>
+
+Random::Random() {
+	Seed(0);
+}
+
+Random::Random(unsigned long long seed) {
+	Seed(seed);
+}
+
+// Spreads the seed over the whole state with splitmix64, so similar seeds give unrelated
+// sequences and the state is never all zero
+void Random::Seed(unsigned long long seed) {
+	for (int i = 0; i < 4; i += 2) {
+		seed += 0x9E3779B97F4A7C15ull;
+		unsigned long long z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		z = z ^ (z >> 31);
+		state[i] = (unsigned int)z;
+		state[i + 1] = (unsigned int)(z >> 32);
+	}
+}
+
+Random Random::Fork() {
+	Random stream = *this;
+	Jump();
+	return stream;
+}
+
+// Equivalent to 2^64 calls to Next()
+void Random::Jump() {
+	static const unsigned int JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+	unsigned int s0 = 0;
+	unsigned int s1 = 0;
+	unsigned int s2 = 0;
+	unsigned int s3 = 0;
+	for (int i = 0; i < 4; i++) {
+		for (int b = 0; b < 32; b++) {
+			if (JUMP[i] & (1u << b)) {
+				s0 ^= state[0];
+				s1 ^= state[1];
+				s2 ^= state[2];
+				s3 ^= state[3];
+			}
+			Next();
+		}
+	}
+	state[0] = s0;
+	state[1] = s1;
+	state[2] = s2;
+	state[3] = s3;
+}
+
+unsigned long long ChooseSeed() {
+	unsigned long long seed;
+	const char *setting = SDL_getenv("SEED");
+	if (setting != NULL) {
+		seed = strtoull(setting, NULL, 10);
+	}
+	else {
+		seed = SDL_GetPerformanceCounter();
+	}
+	std::cout << "Random seed " << seed << " (set SEED to repeat this run)\n";
+	return seed;
+}
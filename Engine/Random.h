@@ -0,0 +1,59 @@
+#pragma once
+
+// Small seeded random number generator (xoshiro128**) to use instead of rand().
+// The sequence only depends on the seed, so runs are reproducible on every platform,
+// and each system or worker thread owns its own generator so nothing is shared.
+// Fork() hands out non-overlapping streams by jumping ahead 2^64 draws at a time.
+class Random {
+public:
+	Random();
+	explicit Random(unsigned long long seed);
+	void Seed(unsigned long long seed);
+
+	// Returns a generator starting at this one's position and moves this one 2^64 draws ahead,
+	// so the two streams never overlap
+	Random Fork();
+	void Jump();
+
+	unsigned int Next() {
+		unsigned int result = Rotate(state[1] * 5, 7) * 9;
+		unsigned int t = state[1] << 9;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = Rotate(state[3], 11);
+		return result;
+	}
+
+	// Uniform float in [0, 1) built from the top 24 bits
+	float NextFloat() {
+		return (Next() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	// Uniform float in [min, max)
+	float NextFloat(float min, float max) {
+		return min + NextFloat() * (max - min);
+	}
+
+	// Uniform int in [0, count) without a division (multiply and keep the high bits)
+	int NextInt(int count) {
+		return (int)(((unsigned long long)Next() * (unsigned int)count) >> 32);
+	}
+
+	bool NextBool() {
+		return (Next() >> 31) != 0;
+	}
+
+	unsigned int state[4];
+
+private:
+	static unsigned int Rotate(unsigned int x, int k) {
+		return (x << k) | (x >> (32 - k));
+	}
+};
+
+// Seed from the SEED environment variable if it is set, otherwise from the clock.
+// Print it so a run can be repeated.
+unsigned long long ChooseSeed();
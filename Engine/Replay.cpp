@@ -0,0 +1,124 @@
+#include "Replay.h"
+#include <fstream>
+#include <iostream>
+
+// File layout: magic, version, seed, timestep, tick count, size of the change list in bytes,
+// four zero bytes, then the change list itself. The header is written as the host lays it
+// out, so its byte order is the host's (little-endian on every platform the games build for);
+// a file from a big-endian host fails the magic check. The fields are placed so the struct
+// has no padding, and any change to them needs a new REPLAY_VERSION.
+struct ReplayHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned long long seed;
+	float timestep;
+	unsigned int ticks;
+	unsigned int dataSize;
+	unsigned int reserved;	// Always 0, keeps the size a multiple of seed's alignment
+};
+
+static_assert(sizeof(ReplayHeader) == 32, "The replay header changed size, bump REPLAY_VERSION");
+
+Replay::Replay() {
+	StartRecording(0, 0.0f);
+}
+
+void Replay::StartRecording(unsigned long long seed, float timestep) {
+	this->seed = seed;
+	this->timestep = timestep;
+	ticks = 0;
+	data.clear();
+	buttons = 0;
+	changeTick = 0;
+}
+
+void Replay::Record(unsigned int buttons) {
+	if (buttons != this->buttons) {
+		WriteVarint(ticks - changeTick);
+		WriteVarint(buttons ^ this->buttons);
+		this->buttons = buttons;
+		changeTick = ticks;
+	}
+	ticks++;
+}
+
+bool Replay::Save(const char *path) const {
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		std::cout << "Unable to write replay " << path << "\n";
+		return false;
+	}
+	ReplayHeader header = { REPLAY_MAGIC, REPLAY_VERSION, seed, timestep, ticks, (unsigned int)data.size(), 0 };
+	file.write((const char *)&header, sizeof(header));
+	file.write((const char *)data.data(), data.size());
+	std::cout << "Saved replay " << path << ": " << ticks << " ticks in " << sizeof(header) + data.size() << " bytes\n";
+	return true;
+}
+
+bool Replay::Load(const char *path) {
+	std::ifstream file(path, std::ios::binary);
+	ReplayHeader header;
+	if (!file || !file.read((char *)&header, sizeof(header))) {
+		std::cout << "Unable to read replay " << path << "\n";
+		return false;
+	}
+	if (header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION) {
+		std::cout << path << " is not a version " << REPLAY_VERSION << " replay\n";
+		return false;
+	}
+	data.resize(header.dataSize);
+	if (!file.read((char *)data.data(), data.size())) {
+		std::cout << "Replay " << path << " is truncated\n";
+		return false;
+	}
+	seed = header.seed;
+	timestep = header.timestep;
+	ticks = header.ticks;
+	StartPlayback();
+	return true;
+}
+
+void Replay::StartPlayback() {
+	buttons = 0;
+	readOffset = 0;
+	playTick = 0;
+	unsigned int delta;
+	changePending = ReadVarint(delta) && ReadVarint(changeBits);
+	changeTick = delta;
+}
+
+bool Replay::Next(unsigned int &buttons) {
+	if (playTick >= ticks) {
+		return false;
+	}
+	if (changePending && playTick == changeTick) {
+		this->buttons ^= changeBits;
+		unsigned int delta;
+		changePending = ReadVarint(delta) && ReadVarint(changeBits);
+		changeTick += delta;
+	}
+	buttons = this->buttons;
+	playTick++;
+	return true;
+}
+
+// 7 bits per byte, high bit set on every byte but the last
+void Replay::WriteVarint(unsigned int value) {
+	while (value >= 0x80) {
+		data.push_back((unsigned char)(value | 0x80));
+		value >>= 7;
+	}
+	data.push_back((unsigned char)value);
+}
+
+bool Replay::ReadVarint(unsigned int &value) {
+	value = 0;
+	for (int shift = 0; shift < 35 && readOffset < data.size(); shift += 7) {
+		unsigned char byte = data[readOffset++];
+		value |= (unsigned int)(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
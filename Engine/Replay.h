@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#define REPLAY_MAGIC 0x594c5052	// "RPLY"
+#define REPLAY_VERSION 1
+
+// Records the buttons held on every simulation tick of one game, together with the seed and
+// tick length, so the game can be played back exactly through the same simulation code.
+// Buttons are a bitmask the game defines. Only ticks where the mask changes are stored, each as
+// (ticks since the last change, bits that flipped) in variable-length integers, so holding a
+// direction for a second costs two or three bytes instead of sixty masks.
+class Replay {
+public:
+	Replay();
+
+	void StartRecording(unsigned long long seed, float timestep);
+	// Call once per tick with the buttons that tick ran with
+	void Record(unsigned int buttons);
+	bool Save(const char *path) const;
+
+	bool Load(const char *path);
+	void StartPlayback();
+	// Buttons for the next tick. Returns false once every recorded tick has been played.
+	bool Next(unsigned int &buttons);
+
+	unsigned long long seed;
+	float timestep;
+	unsigned int ticks;
+
+private:
+	void WriteVarint(unsigned int value);
+	bool ReadVarint(unsigned int &value);
+
+	std::vector<unsigned char> data;
+	unsigned int buttons;		// Mask after the last change recorded or played
+	unsigned int changeTick;	// Tick of the last change recorded, or of the next change to play
+	unsigned int changeBits;	// Bits that flip on changeTick during playback
+	bool changePending;
+	size_t readOffset;
+	unsigned int playTick;
+};
@@ -1,7 +1,10 @@
 
 #include "ShaderProgram.h"
+#include "GLStats.h"
+#include "Trace.h"
 
 void ShaderProgram::Load(const char *vertexShaderFile, const char *fragmentShaderFile) {
+    TRACE_SCOPE("ShaderProgram::Load");
     
     // create the vertex shader
     vertexShader = LoadShaderFromFile(vertexShaderFile, GL_VERTEX_SHADER);
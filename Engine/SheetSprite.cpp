@@ -0,0 +1,47 @@
+#include "SheetSprite.h"
+#include "GLStats.h"
+
+SheetSprite::SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size, bool mirrored) {
+	this->textureID = textureID;
+	this->u = u;
+	this->v = v;
+	this->width = width;
+	this->height = height;
+	this->size = size;
+	this->mirrored = mirrored;
+}
+
+void SheetSprite::Draw(ShaderProgram &program) {
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	float aspectRatio = width / height;
+	float vertices[] = {
+		-0.5f * size * aspectRatio, -0.5f * size,
+		 0.5f * size * aspectRatio,  0.5f * size,
+		-0.5f * size * aspectRatio,  0.5f * size,
+		 0.5f * size * aspectRatio,  0.5f * size,
+		-0.5f * size * aspectRatio, -0.5f * size,
+		 0.5f * size * aspectRatio, -0.5f * size
+	};
+	float left = mirrored ? u + width : u;
+	float right = mirrored ? u : u + width;
+	float texCoords[] = {
+		left, v + height,
+		right, v,
+		left, v,
+		right, v,
+		left, v + height,
+		right, v + height
+	};
+
+	// The caller has set the model matrix, which already made program current
+	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertices);
+	glEnableVertexAttribArray(program.positionAttribute);
+
+	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoords);
+	glEnableVertexAttribArray(program.texCoordAttribute);
+
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glDisableVertexAttribArray(program.positionAttribute);
+	glDisableVertexAttribArray(program.texCoordAttribute);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ShaderProgram.h"
+
+// A sprite cut out of a sprite sheet. u, v, width and height are texture coordinates and size
+// is the drawn height; the width follows the sprite's aspect ratio.
+class SheetSprite {
+public:
+	SheetSprite() { mirrored = false; }
+	SheetSprite(unsigned int textureID, float u, float v, float width, float height, float size, bool mirrored = false);
+	// Draws the sprite centered on the origin with program's current model matrix
+	void Draw(ShaderProgram &program);
+
+	float u;
+	float v;
+	float width;
+	float height;
+	float size;
+	unsigned int textureID;
+	bool mirrored;		// Flipped left to right
+};
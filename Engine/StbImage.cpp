@@ -0,0 +1,3 @@
+// stb_image's implementation, compiled once for every game
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
@@ -0,0 +1,150 @@
+#include "StressTest.h"
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+StressTest::StressTest() {
+	active = false;
+	step = 1;
+	frame = 0;
+	budgetMs = STRESS_BUDGET_MS;
+	stepSeconds = STRESS_STEP_SECONDS;
+	overSeconds = STRESS_OVER_SECONDS;
+	outPath = "stress.csv";
+	countIndex = 0;
+	stepMs = 0.0f;
+	overMs = 0.0f;
+}
+
+bool StressTest::ParseArguments(int argc, char *argv[]) {
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (argument == "--stress") {
+			active = true;
+		} else if (i + 1 == argc) {
+			break;
+		} else if (argument == "--budget") {
+			budgetMs = std::max((float)atof(argv[++i]), 0.1f);
+		} else if (argument == "--step-seconds") {
+			stepSeconds = std::max((float)atof(argv[++i]), 0.1f);
+		} else if (argument == "--over-seconds") {
+			overSeconds = std::max((float)atof(argv[++i]), 0.1f);
+		} else if (argument == "--out") {
+			outPath = argv[++i];
+		}
+	}
+	if (!active) {
+		return false;
+	}
+	std::cout << "Stress test: raising the load every " << stepSeconds << " s until tick plus render stays over "
+		<< budgetMs << " ms for " << overSeconds << " s\n";
+	return true;
+}
+
+void StressTest::RecordCount(const char *name, double value) {
+	if (countIndex == (int)countNames.size()) {
+		countNames.push_back(name);
+		countSums.push_back(0.0);
+	}
+	countSums[countIndex++] += value;
+}
+
+void StressTest::RecordFrame(const FrameProfiler &profiler) {
+	frame++;
+	countIndex = 0;
+	workMs.push_back(profiler.PhaseMs(PHASE_UPDATE, 0) + profiler.PhaseMs(PHASE_RENDER, 0));
+	stepMs += profiler.FrameMs(0);
+	if (stepMs >= stepSeconds * 1000.0f) {
+		EndStep();
+	}
+}
+
+void StressTest::EndStep() {
+	StressStep result;
+	result.step = step;
+	result.frames = (int)workMs.size();
+	for (size_t i = 0; i < countSums.size(); i++) {
+		result.counts.push_back(countSums[i] / result.frames);
+		countSums[i] = 0.0;
+	}
+	result.workP50 = Benchmark::Percentile(workMs, 50.0f);
+	result.workP95 = Benchmark::Percentile(workMs, 95.0f);
+	result.overBudget = result.workP50 > budgetMs;
+	steps.push_back(result);
+
+	overMs = result.overBudget ? overMs + stepMs : 0.0f;
+	std::streamsize precision = std::cout.precision();
+	std::cout << "Step " << step << ": " << std::fixed << std::setprecision(2) << result.workP50 << " ms"
+		<< (result.overBudget ? " (over budget)" : "") << "\n" << std::defaultfloat << std::setprecision(precision);
+	workMs.clear();
+	stepMs = 0.0f;
+	step++;
+}
+
+bool StressTest::Done() const {
+	return overMs >= overSeconds * 1000.0f || (int)steps.size() >= STRESS_MAX_STEPS;
+}
+
+int StressTest::Finish(const char *game) {
+	if (steps.empty()) {
+		std::cout << "Stress test ended before the first step was over\n";
+		return 1;
+	}
+
+	// The last step within budget, so a lone slow step on the way up doesn't count as the limit
+	int sustainable = -1;
+	for (int i = (int)steps.size() - 1; i >= 0; i--) {
+		if (!steps[i].overBudget) {
+			sustainable = i;
+			break;
+		}
+	}
+
+	std::ofstream csv(outPath);
+	csv << "game,step";
+	for (size_t c = 0; c < countNames.size(); c++) {
+		csv << "," << countNames[c];
+	}
+	csv << ",work_p50_ms,work_p95_ms,frames,over_budget\n";
+
+	std::cout << game << " stress test, " << budgetMs << " ms budget:\n" << std::setw(6) << "step";
+	for (size_t c = 0; c < countNames.size(); c++) {
+		std::cout << std::setw(11) << countNames[c];
+	}
+	std::cout << std::setw(9) << "p50 ms" << std::setw(9) << "p95 ms" << std::setw(8) << "frames" << "\n";
+	std::streamsize precision = std::cout.precision();
+	std::cout << std::fixed;
+	for (size_t i = 0; i < steps.size(); i++) {
+		const StressStep &result = steps[i];
+		csv << game << "," << result.step;
+		std::cout << std::setprecision(0) << std::setw(6) << result.step;
+		for (size_t c = 0; c < result.counts.size(); c++) {
+			csv << "," << result.counts[c];
+			std::cout << std::setw(11) << result.counts[c];
+		}
+		csv << "," << result.workP50 << "," << result.workP95 << "," << result.frames << "," << (result.overBudget ? 1 : 0) << "\n";
+		std::cout << std::setprecision(2) << std::setw(9) << result.workP50 << std::setw(9) << result.workP95
+			<< std::setw(8) << result.frames << (result.overBudget ? "  over" : "") << "\n";
+	}
+	std::cout << std::defaultfloat << std::setprecision(precision);
+
+	if (sustainable < 0) {
+		std::cout << "Even the first step went over the " << budgetMs << " ms budget\n";
+	}
+	else {
+		const StressStep &result = steps[sustainable];
+		std::cout << "Maximum sustainable load: step " << result.step;
+		for (size_t c = 0; c < result.counts.size(); c++) {
+			std::cout << (c == 0 ? " (" : ", ") << (int)(result.counts[c] + 0.5) << " " << countNames[c];
+		}
+		std::cout << (result.counts.empty() ? "" : ")") << " at " << result.workP50 << " ms\n";
+	}
+	if (!Done()) {
+		std::cout << "The run was stopped before the load went over budget for " << overSeconds << " s\n";
+	}
+	std::cout << "Wrote " << outPath << "\n";
+	return 0;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "FrameProfiler.h"
+#include <string>
+#include <vector>
+
+#define STRESS_BUDGET_MS 16.6f		// Tick plus render time a frame may take, a 60 Hz frame by default
+#define STRESS_STEP_SECONDS 1.0f	// Time the game runs at each load before the next step raises it
+#define STRESS_OVER_SECONDS 3.0f	// Over budget this long in a row ends the run
+#define STRESS_MAX_STEPS 1000
+
+// Load held during one step and the time it took
+struct StressStep {
+	int step;
+	std::vector<double> counts;	// Average of each recorded count over the step
+	float workP50;				// Tick plus render milliseconds
+	float workP95;
+	int frames;
+	bool overBudget;			// workP50 went over the budget
+};
+
+// Ramps a game's load up until it can't keep to a frame budget.
+//
+//   <game> --stress [--budget <ms>] [--step-seconds <s>] [--over-seconds <s>] [--out <csv>]
+//
+// The game runs uncapped, one tick per frame, and raises its load every step (step counts
+// from 1 and the game decides what each step holds). A step is over budget when its median
+// tick plus render time is. Once the steps over budget in a row cover --over-seconds the run
+// ends, and Finish() prints the load at each step along with the highest one that kept to
+// the budget, and writes the curve to the CSV (stress.csv by default) to compare builds or
+// machines with.
+class StressTest {
+public:
+	StressTest();
+
+	// Returns true if the arguments ask for a stress run
+	bool ParseArguments(int argc, char *argv[]);
+
+	// Records a count the game held this frame (name is a string literal), averaged over each
+	// step. Call for the same names in the same order every frame, before RecordFrame().
+	void RecordCount(const char *name, double value);
+	// Call once per frame after profiler.EndFrame(). Moves to the next step when this one is over.
+	void RecordFrame(const FrameProfiler &profiler);
+	bool Done() const;
+
+	// Prints the curve and the maximum sustainable load, writes the CSV and returns the exit code
+	int Finish(const char *game);
+
+	bool active;
+	int step;
+	int frame;			// Frames run so far
+	float budgetMs;
+
+private:
+	void EndStep();
+
+	float stepSeconds;
+	float overSeconds;
+	std::string outPath;
+
+	std::vector<const char *> countNames;
+	std::vector<double> countSums;
+	int countIndex;		// Next count RecordCount() expects this frame
+	std::vector<float> workMs;	// Tick plus render of every frame of the current step
+	float stepMs;		// Wall time of the current step so far
+	float overMs;		// Wall time of the steps over budget in a row, the current one excluded
+	std::vector<StressStep> steps;
+};
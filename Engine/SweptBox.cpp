@@ -0,0 +1,66 @@
+#include "SweptBox.h"
+#include "BoxOverlap.h"
+#include <math.h>
+
+// Narrows [enter, exit] to the part of the move where the center is inside one slab.
+// Returns false once the interval is empty.
+static bool ClipSlab(float start, float delta, float slabCenter, float slabHalfSize, float &enter, float &exit) {
+	if (delta == 0.0f) {
+		// Not moving on this axis, so the center is either always or never inside the slab
+		return fabsf(start - slabCenter) <= slabHalfSize;
+	}
+	float t1 = (slabCenter - slabHalfSize - start) / delta;
+	float t2 = (slabCenter + slabHalfSize - start) / delta;
+	if (t1 > t2) {
+		float swap = t1;
+		t1 = t2;
+		t2 = swap;
+	}
+	if (t1 > enter) {
+		enter = t1;
+	}
+	if (t2 < exit) {
+		exit = t2;
+	}
+	return enter <= exit;
+}
+
+float SweepBox(float x, float y, float halfWidth, float halfHeight, float deltaX, float deltaY,
+	float boxX, float boxY, float boxHalfWidth, float boxHalfHeight) {
+	float enter = 0.0f;
+	float exit = 1.0f;
+	if (!ClipSlab(x, deltaX, boxX, boxHalfWidth + halfWidth, enter, exit) ||
+		!ClipSlab(y, deltaY, boxY, boxHalfHeight + halfHeight, enter, exit)) {
+		return -1.0f;
+	}
+	return enter;
+}
+
+int FirstSweptHit(float x, float y, float halfWidth, float halfHeight, float deltaX, float deltaY,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t count, const char *skip, unsigned int *mask, float *timeOfImpact) {
+	// Broadphase: a box the move can touch overlaps the box around the start and end positions
+	OverlapBoxes(x + deltaX * 0.5f, y + deltaY * 0.5f, halfWidth + fabsf(deltaX) * 0.5f, halfHeight + fabsf(deltaY) * 0.5f,
+		boxX, boxY, boxHalfWidth, boxHalfHeight, count, mask);
+
+	int first = -1;
+	float firstTime = 2.0f;
+	size_t words = BOX_MASK_WORDS(count);
+	for (size_t w = 0; w < words; w++) {
+		unsigned int bits = mask[w];
+		for (size_t i = w * 32; bits != 0; i++, bits >>= 1) {
+			if ((bits & 1u) == 0 || (skip != NULL && skip[i])) {
+				continue;
+			}
+			float t = SweepBox(x, y, halfWidth, halfHeight, deltaX, deltaY, boxX[i], boxY[i], boxHalfWidth[i], boxHalfHeight[i]);
+			if (t >= 0.0f && t < firstTime) {
+				first = (int)i;
+				firstTime = t;
+			}
+		}
+	}
+	if (first >= 0) {
+		*timeOfImpact = firstTime;
+	}
+	return first;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+
+// Swept box tests for fast movers. A box moving by (deltaX, deltaY) over a tick is tested
+// against a target box by growing the target by the mover's half extents and casting the
+// mover's center along the move (slab test). The result is the time of impact as a fraction
+// of the tick: 0 when the boxes already overlap at the start, 1 at the end of the move.
+// Touching edges count as a hit, like OverlapBoxes().
+
+// Returns the time of impact (0 to 1), or -1 if the boxes never touch during the move.
+// For a moving target, pass the mover's delta minus the target's delta.
+float SweepBox(float x, float y, float halfWidth, float halfHeight, float deltaX, float deltaY,
+	float boxX, float boxY, float boxHalfWidth, float boxHalfHeight);
+
+// Sweeps one box against count static boxes stored as separate arrays. The OverlapBoxes()
+// kernel first finds the boxes that touch the bounding box of the whole move, writing them to
+// mask (scratch space of BOX_MASK_WORDS(count) words), and only those are swept. Boxes with
+// skip[i] set are passed over (skip may be NULL). Returns the index of the box hit first along
+// the move and stores its time of impact, or returns -1 if none are hit.
+int FirstSweptHit(float x, float y, float halfWidth, float halfHeight, float deltaX, float deltaY,
+	const float *boxX, const float *boxY, const float *boxHalfWidth, const float *boxHalfHeight,
+	size_t count, const char *skip, unsigned int *mask, float *timeOfImpact);
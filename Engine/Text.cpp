@@ -0,0 +1,51 @@
+#include "Text.h"
+#include "GLStats.h"
+#include <cstring>
+
+void BuildTextMesh(const char *text, float size, float spacing, ArenaVector<float> &vertexData, ArenaVector<float> &texCoordData) {
+	// Reserved up front, an arena vector that grows leaves its old arrays behind until the frame ends
+	size_t length = strlen(text);
+	vertexData.reserve(vertexData.size() + length * 12);
+	texCoordData.reserve(texCoordData.size() + length * 12);
+	float character_size = 1.0 / 16.0f;
+	for (size_t i = 0; i < length; i++) {
+		int spriteIndex = (int)text[i];
+		float texture_x = (float)(spriteIndex % 16) / 16.0f;
+		float texture_y = (float)(spriteIndex / 16) / 16.0f;
+		vertexData.insert(vertexData.end(), {
+			((size + spacing) * i) + (-0.5f * size),  0.5f * size,
+			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
+			((size + spacing) * i) +  (0.5f * size),  0.5f * size,
+			((size + spacing) * i) +  (0.5f * size), -0.5f * size,
+			((size + spacing) * i) +  (0.5f * size),  0.5f * size,
+			((size + spacing) * i) + (-0.5f * size), -0.5f * size,
+		});
+		texCoordData.insert(texCoordData.end(), {
+			texture_x, texture_y,
+			texture_x, texture_y + character_size,
+			texture_x + character_size, texture_y,
+			texture_x + character_size, texture_y + character_size,
+			texture_x + character_size, texture_y,
+			texture_x, texture_y + character_size,
+		});
+	}
+}
+
+void DrawText(ShaderProgram &program, int fontTexture, const char *text, float size, float spacing) {
+	ArenaVector<float> vertexData;
+	ArenaVector<float> texCoordData;
+	BuildTextMesh(text, size, spacing, vertexData, texCoordData);
+	glBindTexture(GL_TEXTURE_2D, fontTexture);
+
+	// draw this data (use the .data() method of std::vector to get pointer to data)
+	glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, vertexData.data());
+	glEnableVertexAttribArray(program.positionAttribute);
+
+	glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, texCoordData.data());
+	glEnableVertexAttribArray(program.texCoordAttribute);
+
+	// draw this yourself, use vertexData.size()/2 to get number of vertices
+	glDrawArrays(GL_TRIANGLES, 0, (int)vertexData.size() / 2);
+	glDisableVertexAttribArray(program.positionAttribute);
+	glDisableVertexAttribArray(program.texCoordAttribute);
+}
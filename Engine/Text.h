@@ -0,0 +1,12 @@
+#pragma once
+
+#include "ShaderProgram.h"
+#include "FrameArena.h"
+
+// Text drawn from a 16x16 grid of ASCII characters in one texture
+
+// Appends two triangles per character of text to the vertex and texture coordinate arrays
+void BuildTextMesh(const char *text, float size, float spacing, ArenaVector<float> &vertexData, ArenaVector<float> &texCoordData);
+// Draws text starting at program's current model matrix, one draw call for the whole string.
+// The vertices come from the frame arena.
+void DrawText(ShaderProgram &program, int fontTexture, const char *text, float size, float spacing);
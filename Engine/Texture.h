@@ -0,0 +1,10 @@
+#pragma once
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+
+// Loads an image in any format stb_image reads into an RGBA texture with linear filtering
+GLuint LoadTexture(const char *filePath);
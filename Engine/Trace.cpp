@@ -0,0 +1,149 @@
+#include "Trace.h"
+
+#ifdef TRACING
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum TraceEventType { TRACE_EVENT_SCOPE, TRACE_EVENT_COUNTER };
+
+// 32 bytes, two to a cache line
+struct TraceEvent {
+	const char *name;
+	unsigned long long start;
+	union {
+		unsigned long long end;		// Scopes
+		double value;				// Counters
+	};
+	int type;
+};
+
+struct TraceRing {
+	TraceEvent events[TRACE_RING_EVENTS];
+	std::atomic<unsigned long long> written;	// Events ever written; the next one goes to written % TRACE_RING_EVENTS
+	int thread;
+	std::string name;
+};
+
+// Rings are never freed, a thread's events stay in the trace after it exits
+std::mutex ringsLock;
+std::vector<TraceRing *> rings;
+thread_local TraceRing *threadRing = NULL;
+
+std::string tracePath = "trace.json";
+unsigned long long setupTicks = 0;
+Uint64 setupCounter = 0;
+
+TraceRing *CreateRing() {
+	TraceRing *ring = new TraceRing();
+	ring->written = 0;
+	std::lock_guard<std::mutex> guard(ringsLock);
+	ring->thread = (int)rings.size();
+	ring->name = "Thread " + std::to_string(ring->thread);
+	rings.push_back(ring);
+	return ring;
+}
+
+inline TraceEvent &NextEvent(TraceRing *&ring, unsigned long long &index) {
+	if (ring == NULL) {
+		ring = CreateRing();
+	}
+	index = ring->written.load(std::memory_order_relaxed);
+	return ring->events[index & (TRACE_RING_EVENTS - 1)];
+}
+
+}
+
+void TraceRecordScope(const char *name, unsigned long long start, unsigned long long end) {
+	unsigned long long index;
+	TraceEvent &event = NextEvent(threadRing, index);
+	event.name = name;
+	event.start = start;
+	event.end = end;
+	event.type = TRACE_EVENT_SCOPE;
+	threadRing->written.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecordCounter(const char *name, double value) {
+	unsigned long long index;
+	TraceEvent &event = NextEvent(threadRing, index);
+	event.name = name;
+	event.start = TraceTimestamp();
+	event.value = value;
+	event.type = TRACE_EVENT_COUNTER;
+	threadRing->written.store(index + 1, std::memory_order_release);
+}
+
+void TraceNameThread(const std::string &name) {
+	if (threadRing == NULL) {
+		threadRing = CreateRing();
+	}
+	std::lock_guard<std::mutex> guard(ringsLock);
+	threadRing->name = name;
+}
+
+void TraceSetup(const char *defaultPath) {
+	TraceNameThread("Main");
+	const char *setting = SDL_getenv("TRACE_FILE");
+	tracePath = setting != NULL ? setting : defaultPath;
+	setupTicks = TraceTimestamp();
+	setupCounter = SDL_GetPerformanceCounter();
+	std::cout << "Tracing to " << tracePath << "\n";
+}
+
+bool TraceFlush() {
+	// Time stamp counter ticks per microsecond, measured against SDL's clock since TraceSetup()
+	double elapsedSeconds = (double)(SDL_GetPerformanceCounter() - setupCounter) / SDL_GetPerformanceFrequency();
+	double ticksPerMicrosecond = elapsedSeconds > 0.0 ? (TraceTimestamp() - setupTicks) / (elapsedSeconds * 1e6) : 1.0;
+#ifndef TRACE_RDTSC
+	ticksPerMicrosecond = SDL_GetPerformanceFrequency() / 1e6;
+#endif
+
+	std::ofstream file(tracePath);
+	if (!file) {
+		std::cout << "Unable to write trace " << tracePath << "\n";
+		return false;
+	}
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file.setf(std::ios::fixed);
+	file.precision(3);
+
+	std::lock_guard<std::mutex> guard(ringsLock);
+	size_t eventCount = 0;
+	for (size_t r = 0; r < rings.size(); r++) {
+		const TraceRing &ring = *rings[r];
+		file << (r > 0 ? ",\n" : "") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring.thread
+			<< ",\"args\":{\"name\":\"" << ring.name << "\"}}";
+
+		unsigned long long written = ring.written.load(std::memory_order_acquire);
+		unsigned long long first = written > TRACE_RING_EVENTS ? written - TRACE_RING_EVENTS : 0;
+		for (unsigned long long i = first; i < written; i++) {
+			const TraceEvent &event = ring.events[i & (TRACE_RING_EVENTS - 1)];
+			// Events from before TraceSetup() would come out with negative times
+			if (event.start < setupTicks) {
+				continue;
+			}
+			double timestamp = (event.start - setupTicks) / ticksPerMicrosecond;
+			if (event.type == TRACE_EVENT_SCOPE) {
+				file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring.thread
+					<< ",\"ts\":" << timestamp << ",\"dur\":" << (event.end - event.start) / ticksPerMicrosecond << "}";
+			}
+			else {
+				file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"C\",\"pid\":1,\"tid\":" << ring.thread
+					<< ",\"ts\":" << timestamp << ",\"args\":{\"value\":" << event.value << "}}";
+			}
+			eventCount++;
+		}
+	}
+	file << "\n]}\n";
+	std::cout << "Wrote " << eventCount << " trace events to " << tracePath << "\n";
+	return true;
+}
+
+#endif
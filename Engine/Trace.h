@@ -0,0 +1,79 @@
+#pragma once
+
+// Scoped tracing for Chrome's about:tracing and Perfetto (ui.perfetto.dev).
+//
+//   TRACE_SCOPE("Update");                     // Times the rest of the enclosing block
+//   TRACE_COUNTER("Enemies", enemies.Count()); // Plots a value over time
+//
+// Build with TRACING defined to record. Without it the macros compile to nothing and
+// TraceSetup()/TraceFlush() are empty, so the calls can stay in release code.
+//
+// Each thread records into its own ring of TRACE_RING_EVENTS events: a scope is two
+// timestamp reads and one write into the ring when it closes, with no locks. Once a ring is
+// full the oldest events are overwritten. TraceFlush() writes everything still in the rings
+// to the trace file (TRACE_FILE, or the default passed to TraceSetup()); the games flush on
+// exit, and Alien Invasion on F4 as well. Flush from the main thread between frames, since
+// a worker still recording may overwrite events while they are being written out.
+
+#ifdef TRACING
+
+#include <SDL.h>
+#include <string>
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define TRACE_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRACE_RDTSC 1
+#endif
+
+#define TRACE_RING_EVENTS 65536		// Per thread, a power of two
+
+// The time stamp counter is read directly where there is one; TraceFlush() converts it to
+// microseconds against SDL's clock
+inline unsigned long long TraceTimestamp() {
+#ifdef TRACE_RDTSC
+	return __rdtsc();
+#else
+	return SDL_GetPerformanceCounter();
+#endif
+}
+
+// Adds a finished scope or a counter value to this thread's ring. name must outlive the
+// trace (a string literal).
+void TraceRecordScope(const char *name, unsigned long long start, unsigned long long end);
+void TraceRecordCounter(const char *name, double value);
+// Names this thread's row in the trace (copied)
+void TraceNameThread(const std::string &name);
+
+class TraceScope {
+public:
+	explicit TraceScope(const char *name) : name(name), start(TraceTimestamp()) {}
+	~TraceScope() { TraceRecordScope(name, start, TraceTimestamp()); }
+
+private:
+	const char *name;
+	unsigned long long start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_COUNTER(name, value) TraceRecordCounter(name, (double)(value))
+#define TRACE_THREAD_NAME(name) TraceNameThread(name)
+
+// Picks the trace file (TRACE_FILE overrides defaultPath) and starts the clock. The thread
+// calling it is named Main.
+void TraceSetup(const char *defaultPath);
+// Writes every event still in the rings, returns false if the file couldn't be written
+bool TraceFlush();
+
+#else
+
+#define TRACE_SCOPE(name)
+#define TRACE_COUNTER(name, value)
+#define TRACE_THREAD_NAME(name)
+inline void TraceSetup(const char *) {}
+inline bool TraceFlush() { return true; }
+
+#endif